@@ -0,0 +1,653 @@
+#pragma once
+
+#include <rvv/rvv.hpp>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+// Algorithms over contiguous ranges with the operation written against
+// simd<T>.
+//
+// The driver walks the range in simd<T>::size() chunks, unrolled so that
+// independent chunks overlap in the pipeline, and hands the remaining
+// elements to the same operation through partial (vl limited) loads and
+// stores. The lanes past the end of a range are unspecified inside the
+// operation and never written back.
+
+namespace rvv {
+
+    namespace algorithms_impl {
+
+        using namespace rvv::experimental;
+
+        // chunks per iteration of the main loop
+        inline constexpr std::size_t unroll = 4;
+
+        // independent accumulators of a reduction, enough to cover the
+        // latency of a vector floating point add, integer adds need fewer
+        template <typename T>
+        inline constexpr std::size_t accumulators =
+            std::is_floating_point_v<T> ? 8 : 4;
+
+        template <typename R>
+        using value_t = std::remove_cv_t<std::ranges::range_value_t<R>>;
+
+        // Calls body(i) for every full chunk starting at element i and
+        // tail(i, n) for the last n < Lanes elements
+        template <std::size_t Lanes, typename Body, typename Tail>
+        inline void strip_mine(std::size_t size, Body&& body, Tail&& tail)
+        {
+            std::size_t i = 0;
+            for (; i + unroll * Lanes <= size; i += unroll * Lanes)
+            {
+                [&]<std::size_t... k>(std::index_sequence<k...>) {
+                    (body(i + k * Lanes), ...);
+                }(std::make_index_sequence<unroll>{});
+            }
+            for (; i + Lanes <= size; i += Lanes)
+                body(i);
+            if (i < size)
+                tail(i, size - i);
+        }
+
+        template <typename T>
+        inline simd<T> load(const T* p)
+        {
+            return simd<T>(p, element_aligned);
+        }
+
+        template <typename T>
+        inline simd<T> load(const T* p, std::size_t n)
+        {
+            simd<T> x;
+            x.partial_copy_from(p, n);
+            return x;
+        }
+
+        // the same lanes as a mask of another element type of the same width
+        template <typename U, typename T>
+        inline simd_mask<U> mask_cast(const simd_mask<T>& m)
+        {
+            if constexpr (std::is_same_v<T, U>)
+                return m;
+            else
+                return simd_mask<U>(m);
+        }
+
+        // mask of the first n lanes, compared as unsigned indices so that
+        // n fits for narrow element types
+        template <typename T>
+        inline simd_mask<T> first_lanes(std::size_t n)
+        {
+            using U = rvv_impl::index_of<T>;
+            return mask_cast<T>(simd<U>(simd<U>::index0123) < simd<U>(U(n)));
+        }
+
+        // Writes the lanes of x in keep to out and returns their number
+        template <typename T>
+        inline std::size_t compact_store(
+            const simd<T>& x, const simd_mask<T>& keep, T* out)
+        {
+            std::size_t c = popcount(keep);
+            compact(keep, x).partial_copy_to(out, c);
+            return c;
+        }
+    }    // namespace algorithms_impl
+
+    namespace algorithms {
+
+        using namespace rvv::experimental;
+
+        // out[i] = value
+        template <std::ranges::contiguous_range Out>
+        inline void fill(Out&& out, algorithms_impl::value_t<Out> value)
+        {
+            using T = algorithms_impl::value_t<Out>;
+            T* p = std::ranges::data(out);
+            const simd<T> x(value);
+            algorithms_impl::strip_mine<simd<T>::size()>(
+                std::ranges::size(out),
+                [&](std::size_t i) { x.copy_to(p + i, element_aligned); },
+                [&](std::size_t i, std::size_t n) { x.partial_copy_to(p + i, n); });
+        }
+
+        // copies in to the front of out, which must be at least as large
+        template <std::ranges::contiguous_range In,
+            std::ranges::contiguous_range Out>
+        inline void copy(In&& in, Out&& out)
+        {
+            using T = algorithms_impl::value_t<In>;
+            static_assert(std::is_same_v<T, algorithms_impl::value_t<Out>>,
+                "copy requires ranges of the same value type");
+            const T* src = std::ranges::data(in);
+            T* dst = std::ranges::data(out);
+            algorithms_impl::strip_mine<simd<T>::size()>(
+                std::ranges::size(in),
+                [&](std::size_t i) {
+                    algorithms_impl::load(src + i).copy_to(dst + i, element_aligned);
+                },
+                [&](std::size_t i, std::size_t n) {
+                    algorithms_impl::load(src + i, n).partial_copy_to(dst + i, n);
+                });
+        }
+
+        // out[i] = f(in[i]) with f taking and returning simd, the value
+        // types of in and out must have the same number of lanes
+        template <std::ranges::contiguous_range In,
+            std::ranges::contiguous_range Out, typename F>
+        inline void transform(In&& in, Out&& out, F f)
+        {
+            using T = algorithms_impl::value_t<In>;
+            using U = algorithms_impl::value_t<Out>;
+            static_assert(simd<T>::size() == simd<U>::size(),
+                "transform requires value types of the same size");
+            const T* src = std::ranges::data(in);
+            U* dst = std::ranges::data(out);
+            algorithms_impl::strip_mine<simd<T>::size()>(
+                std::ranges::size(in),
+                [&](std::size_t i) {
+                    simd<U>(f(algorithms_impl::load(src + i)))
+                        .copy_to(dst + i, element_aligned);
+                },
+                [&](std::size_t i, std::size_t n) {
+                    simd<U>(f(algorithms_impl::load(src + i, n)))
+                        .partial_copy_to(dst + i, n);
+                });
+        }
+
+        // out[i] = f(in1[i], in2[i])
+        template <std::ranges::contiguous_range In1,
+            std::ranges::contiguous_range In2,
+            std::ranges::contiguous_range Out, typename F>
+        inline void transform(In1&& in1, In2&& in2, Out&& out, F f)
+        {
+            using T1 = algorithms_impl::value_t<In1>;
+            using T2 = algorithms_impl::value_t<In2>;
+            using U = algorithms_impl::value_t<Out>;
+            static_assert(simd<T1>::size() == simd<U>::size() &&
+                    simd<T2>::size() == simd<U>::size(),
+                "transform requires value types of the same size");
+            const T1* src1 = std::ranges::data(in1);
+            const T2* src2 = std::ranges::data(in2);
+            U* dst = std::ranges::data(out);
+            algorithms_impl::strip_mine<simd<U>::size()>(
+                std::ranges::size(in1),
+                [&](std::size_t i) {
+                    simd<U>(f(algorithms_impl::load(src1 + i),
+                                algorithms_impl::load(src2 + i)))
+                        .copy_to(dst + i, element_aligned);
+                },
+                [&](std::size_t i, std::size_t n) {
+                    simd<U>(f(algorithms_impl::load(src1 + i, n),
+                                algorithms_impl::load(src2 + i, n)))
+                        .partial_copy_to(dst + i, n);
+                });
+        }
+
+        // f(x) modifies a simd& chunk of the range in place
+        template <std::ranges::contiguous_range R, typename F>
+        inline void for_each(R&& range, F f)
+        {
+            using T = algorithms_impl::value_t<R>;
+            T* p = std::ranges::data(range);
+            algorithms_impl::strip_mine<simd<T>::size()>(
+                std::ranges::size(range),
+                [&](std::size_t i) {
+                    simd<T> x = algorithms_impl::load(p + i);
+                    f(x);
+                    x.copy_to(p + i, element_aligned);
+                },
+                [&](std::size_t i, std::size_t n) {
+                    simd<T> x = algorithms_impl::load(p + i, n);
+                    f(x);
+                    x.partial_copy_to(p + i, n);
+                });
+        }
+
+        // out chunk starting at element i is g(i)
+        template <std::ranges::contiguous_range Out, typename G>
+        inline void generate(Out&& out, G g)
+        {
+            using T = algorithms_impl::value_t<Out>;
+            T* p = std::ranges::data(out);
+            algorithms_impl::strip_mine<simd<T>::size()>(
+                std::ranges::size(out),
+                [&](std::size_t i) {
+                    simd<T>(g(i)).copy_to(p + i, element_aligned);
+                },
+                [&](std::size_t i, std::size_t n) {
+                    simd<T>(g(i)).partial_copy_to(p + i, n);
+                });
+        }
+
+        // Copies the elements for which pred (a simd to simd_mask function)
+        // is set to the front of out and returns their number
+        template <std::ranges::contiguous_range In,
+            std::ranges::contiguous_range Out, typename Pred>
+        inline std::size_t copy_if(In&& in, Out&& out, Pred pred)
+        {
+            using T = algorithms_impl::value_t<In>;
+            const T* src = std::ranges::data(in);
+            T* dst = std::ranges::data(out);
+            std::size_t count = 0;
+            algorithms_impl::strip_mine<simd<T>::size()>(
+                std::ranges::size(in),
+                [&](std::size_t i) {
+                    simd<T> x = algorithms_impl::load(src + i);
+                    count += algorithms_impl::compact_store(
+                        x, pred(x), dst + count);
+                },
+                [&](std::size_t i, std::size_t n) {
+                    simd<T> x = algorithms_impl::load(src + i, n);
+                    count += algorithms_impl::compact_store(x,
+                        pred(x) && algorithms_impl::first_lanes<T>(n),
+                        dst + count);
+                });
+            return count;
+        }
+
+        // Removes the elements for which pred is set, keeping the order of
+        // the others, and returns the new size
+        template <std::ranges::contiguous_range R, typename Pred>
+        inline std::size_t remove_if(R&& range, Pred pred)
+        {
+            using T = algorithms_impl::value_t<R>;
+            T* p = std::ranges::data(range);
+            std::size_t count = 0;
+            // the output never overtakes the chunk that has been loaded
+            algorithms_impl::strip_mine<simd<T>::size()>(
+                std::ranges::size(range),
+                [&](std::size_t i) {
+                    simd<T> x = algorithms_impl::load(p + i);
+                    count += algorithms_impl::compact_store(
+                        x, !pred(x), p + count);
+                },
+                [&](std::size_t i, std::size_t n) {
+                    simd<T> x = algorithms_impl::load(p + i, n);
+                    count += algorithms_impl::compact_store(x,
+                        !pred(x) && algorithms_impl::first_lanes<T>(n),
+                        p + count);
+                });
+            return count;
+        }
+
+        // Copies the elements for which pred is set to out_true and the
+        // others to out_false, returns the two counts
+        template <std::ranges::contiguous_range In,
+            std::ranges::contiguous_range OutTrue,
+            std::ranges::contiguous_range OutFalse, typename Pred>
+        inline std::pair<std::size_t, std::size_t> partition_copy(
+            In&& in, OutTrue&& out_true, OutFalse&& out_false, Pred pred)
+        {
+            using T = algorithms_impl::value_t<In>;
+            const T* src = std::ranges::data(in);
+            T* dst_true = std::ranges::data(out_true);
+            T* dst_false = std::ranges::data(out_false);
+            std::size_t count_true = 0, count_false = 0;
+            auto split = [&](const simd<T>& x, const simd_mask<T>& valid) {
+                simd_mask<T> m = pred(x);
+                count_true += algorithms_impl::compact_store(
+                    x, m && valid, dst_true + count_true);
+                count_false += algorithms_impl::compact_store(
+                    x, !m && valid, dst_false + count_false);
+            };
+            algorithms_impl::strip_mine<simd<T>::size()>(
+                std::ranges::size(in),
+                [&](std::size_t i) {
+                    split(algorithms_impl::load(src + i), simd_mask<T>(true));
+                },
+                [&](std::size_t i, std::size_t n) {
+                    split(algorithms_impl::load(src + i, n),
+                        algorithms_impl::first_lanes<T>(n));
+                });
+            return {count_true, count_false};
+        }
+
+        // Moves the elements for which pred is set to the front and returns
+        // their number, the order within both parts is not preserved.
+        //
+        // The first and the last register are kept aside, which leaves room
+        // for one register on either end. Each step reads from the end with
+        // less room, so the compacted halves always fit in the space that has
+        // already been read.
+        template <std::ranges::contiguous_range R, typename Pred>
+        inline std::size_t partition(R&& range, Pred pred)
+        {
+            using T = algorithms_impl::value_t<R>;
+            constexpr std::size_t N = simd<T>::size();
+            T* p = std::ranges::data(range);
+            const std::size_t n = std::ranges::size(range);
+            std::size_t write_left = 0, write_right = n;
+            auto split = [&](const simd<T>& x, const simd_mask<T>& valid) {
+                simd_mask<T> m = pred(x);
+                write_left += algorithms_impl::compact_store(
+                    x, m && valid, p + write_left);
+                simd_mask<T> rest = !m && valid;
+                std::size_t d = popcount(rest);
+                write_right -= d;
+                compact(rest, x).partial_copy_to(p + write_right, d);
+            };
+
+            if (n < 2 * N)
+            {
+                // everything fits in two registers
+                const std::size_t n0 = std::min(n, N);
+                simd<T> x0 = algorithms_impl::load(p, n0);
+                simd<T> x1 = algorithms_impl::load(p + n0, n - n0);
+                split(x0, algorithms_impl::first_lanes<T>(n0));
+                split(x1, algorithms_impl::first_lanes<T>(n - n0));
+                return write_left;
+            }
+
+            const simd<T> first = algorithms_impl::load(p);
+            const simd<T> last = algorithms_impl::load(p + n - N);
+            std::size_t left = N, right = n - N;
+            const simd_mask<T> all(true);
+            while (right - left >= N)
+            {
+                simd<T> x;
+                if (left - write_left <= write_right - right)
+                {
+                    x = algorithms_impl::load(p + left);
+                    left += N;
+                }
+                else
+                {
+                    right -= N;
+                    x = algorithms_impl::load(p + right);
+                }
+                split(x, all);
+            }
+            if (left < right)
+                split(algorithms_impl::load(p + left, right - left),
+                    algorithms_impl::first_lanes<T>(right - left));
+            split(first, all);
+            split(last, all);
+            return write_left;
+        }
+
+        // index of the first element for which pred is set, the size of the
+        // range if there is none
+        template <std::ranges::contiguous_range R, typename Pred>
+        inline std::size_t find_if(R&& range, Pred pred)
+        {
+            using T = algorithms_impl::value_t<R>;
+            constexpr std::size_t N = simd<T>::size();
+            const T* p = std::ranges::data(range);
+            const std::size_t n = std::ranges::size(range);
+            std::size_t i = 0;
+            for (; i + N <= n; i += N)
+            {
+                int k = find_first_set(pred(algorithms_impl::load(p + i)));
+                if (k >= 0)
+                    return i + k;
+            }
+            if (i < n)
+            {
+                int k = find_first_set(pred(algorithms_impl::load(p + i, n - i)) &&
+                    algorithms_impl::first_lanes<T>(n - i));
+                if (k >= 0)
+                    return i + k;
+            }
+            return n;
+        }
+
+        template <std::ranges::contiguous_range R>
+        inline std::size_t find(R&& range, algorithms_impl::value_t<R> value)
+        {
+            using T = algorithms_impl::value_t<R>;
+            const simd<T> v(value);
+            return algorithms::find_if(
+                std::forward<R>(range), [&](const simd<T>& x) { return x == v; });
+        }
+
+        // number of elements for which pred is set
+        template <std::ranges::contiguous_range R, typename Pred>
+        inline std::size_t count_if(R&& range, Pred pred)
+        {
+            using T = algorithms_impl::value_t<R>;
+            const T* p = std::ranges::data(range);
+            std::size_t count = 0;
+            algorithms_impl::strip_mine<simd<T>::size()>(
+                std::ranges::size(range),
+                [&](std::size_t i) {
+                    count += popcount(pred(algorithms_impl::load(p + i)));
+                },
+                [&](std::size_t i, std::size_t n) {
+                    count += popcount(pred(algorithms_impl::load(p + i, n)) &&
+                        algorithms_impl::first_lanes<T>(n));
+                });
+            return count;
+        }
+
+        template <std::ranges::contiguous_range R>
+        inline std::size_t count(R&& range, algorithms_impl::value_t<R> value)
+        {
+            using T = algorithms_impl::value_t<R>;
+            const simd<T> v(value);
+            return algorithms::count_if(
+                std::forward<R>(range), [&](const simd<T>& x) { return x == v; });
+        }
+
+        // index of the first position where the ranges differ, the size of
+        // the shorter range if there is none
+        template <std::ranges::contiguous_range R1,
+            std::ranges::contiguous_range R2>
+        inline std::size_t mismatch(R1&& range1, R2&& range2)
+        {
+            using T = algorithms_impl::value_t<R1>;
+            static_assert(std::is_same_v<T, algorithms_impl::value_t<R2>>,
+                "mismatch requires ranges of the same value type");
+            constexpr std::size_t N = simd<T>::size();
+            const T* a = std::ranges::data(range1);
+            const T* b = std::ranges::data(range2);
+            const std::size_t n =
+                std::min(std::ranges::size(range1), std::ranges::size(range2));
+            std::size_t i = 0;
+            for (; i + N <= n; i += N)
+            {
+                int k = find_first_set(
+                    algorithms_impl::load(a + i) != algorithms_impl::load(b + i));
+                if (k >= 0)
+                    return i + k;
+            }
+            if (i < n)
+            {
+                int k = find_first_set((algorithms_impl::load(a + i, n - i) !=
+                                           algorithms_impl::load(b + i, n - i)) &&
+                    algorithms_impl::first_lanes<T>(n - i));
+                if (k >= 0)
+                    return i + k;
+            }
+            return n;
+        }
+
+        // out[j] is the index of the first element of sorted that is not
+        // less than queries[j].
+        //
+        // Each lane runs its own branchless binary search: every step gathers
+        // the probe of all lanes and moves the lanes whose probe is less than
+        // the query, all lanes take the same log2(n) steps. Several registers
+        // of queries are searched together so that their gathers overlap.
+        // The element type is 32 or 64 bits wide and out holds
+        // rvv_impl::index_of of it, 32-bit sorted ranges hold less than 2^30
+        // elements.
+        template <std::ranges::contiguous_range Sorted,
+            std::ranges::contiguous_range Queries,
+            std::ranges::contiguous_range Out>
+        inline void lower_bound_many(
+            Sorted&& sorted, Queries&& queries, Out&& out)
+        {
+            using T = algorithms_impl::value_t<Sorted>;
+            using I = rvv_impl::index_of<T>;
+            static_assert(sizeof(T) >= 4,
+                "lower_bound_many only works for 32 and 64-bit types");
+            static_assert(std::is_same_v<T, algorithms_impl::value_t<Queries>> &&
+                    std::is_same_v<I, algorithms_impl::value_t<Out>>,
+                "lower_bound_many requires queries of the sorted type and "
+                "indices of its width");
+            constexpr std::size_t N = simd<T>::size();
+            const T* p = std::ranges::data(sorted);
+            const std::size_t n = std::ranges::size(sorted);
+            const T* q = std::ranges::data(queries);
+            const std::size_t m = std::ranges::size(queries);
+            I* r = std::ranges::data(out);
+            if (n == 0)
+            {
+                algorithms::fill(std::span(r, m), I(0));
+                return;
+            }
+
+            const simd<I> zero(I(0)), one(I(1));
+            auto search = [&]<std::size_t K>(std::size_t i,
+                              std::integral_constant<std::size_t, K>,
+                              std::size_t count) {
+                std::array<simd<T>, K> x;
+                std::array<simd<I>, K> base;
+                for (std::size_t k = 0; k < K; k++)
+                {
+                    x[k] = algorithms_impl::load(q + i + k * N, count);
+                    base[k] = zero;
+                }
+                for (std::size_t len = n; len > 1;)
+                {
+                    const std::size_t half = len / 2;
+                    for (std::size_t k = 0; k < K; k++)
+                    {
+                        simd<I> probe = base[k] + I(half);
+                        base[k] = choose(algorithms_impl::mask_cast<I>(
+                                             gather(p, probe) < x[k]),
+                            probe, base[k]);
+                    }
+                    len -= half;
+                }
+                for (std::size_t k = 0; k < K; k++)
+                {
+                    base[k] += choose(algorithms_impl::mask_cast<I>(
+                                          gather(p, base[k]) < x[k]),
+                        one, zero);
+                    base[k].partial_copy_to(r + i + k * N, count);
+                }
+            };
+
+            std::size_t i = 0;
+            for (; i + algorithms_impl::unroll * N <= m;
+                 i += algorithms_impl::unroll * N)
+                search(i,
+                    std::integral_constant<std::size_t, algorithms_impl::unroll>{},
+                    N);
+            for (; i + N <= m; i += N)
+                search(i, std::integral_constant<std::size_t, 1>{}, N);
+            if (i < m)
+                search(i, std::integral_constant<std::size_t, 1>{}, m - i);
+        }
+
+        // Combines transform(in[i]) with reduce_op, both applied to simd.
+        // reduce_op must be associative and commutative, the lanes are
+        // combined in an unspecified order.
+        //
+        // The chunks go round robin into accumulators<T> independent vector
+        // accumulators so that consecutive reduce_op calls do not wait on
+        // each other, the accumulators are combined and reduced across
+        // lanes only once at the end.
+        template <std::ranges::contiguous_range In, typename T,
+            typename ReduceOp, typename TransformOp>
+        inline T transform_reduce(
+            In&& in, T init, ReduceOp reduce_op, TransformOp transform_op)
+        {
+            using V = algorithms_impl::value_t<In>;
+            static_assert(simd<V>::size() == simd<T>::size(),
+                "transform_reduce requires value types of the same size");
+            constexpr std::size_t lanes = simd<T>::size();
+            constexpr std::size_t K = algorithms_impl::accumulators<T>;
+            const V* src = std::ranges::data(in);
+            const std::size_t size = std::ranges::size(in);
+            auto chunk = [&](std::size_t i) {
+                return simd<T>(transform_op(algorithms_impl::load(src + i)));
+            };
+
+            if (size < lanes)
+            {
+                if (size == 0)
+                    return init;
+                simd<T> x = transform_op(algorithms_impl::load(src, size));
+                for (std::size_t i = 0; i < size; i++)
+                    init = simd<T>(reduce_op(simd<T>(init), simd<T>(x[i])))[0];
+                return init;
+            }
+
+            // the first chunks start the accumulators
+            std::array<simd<T>, K> acc;
+            const std::size_t used = std::min(K, size / lanes);
+            for (std::size_t k = 0; k < used; k++)
+                acc[k] = chunk(k * lanes);
+
+            std::size_t i = used * lanes;
+            for (; i + K * lanes <= size; i += K * lanes)
+            {
+                [&]<std::size_t... k>(std::index_sequence<k...>) {
+                    ((acc[k] = reduce_op(acc[k], chunk(i + k * lanes))), ...);
+                }(std::make_index_sequence<K>{});
+            }
+            for (std::size_t k = 0; i + lanes <= size; i += lanes, k++)
+                acc[k] = reduce_op(acc[k], chunk(i));
+            if (i < size)
+            {
+                simd<T> x =
+                    transform_op(algorithms_impl::load(src + i, size - i));
+                acc[0] = choose(algorithms_impl::first_lanes<T>(size - i),
+                    simd<T>(reduce_op(acc[0], x)), acc[0]);
+            }
+
+            for (std::size_t step = 1; step < used; step *= 2)
+                for (std::size_t k = 0; k + step < used; k += 2 * step)
+                    acc[k] = reduce_op(acc[k], acc[k + step]);
+            return simd<T>(reduce_op(
+                simd<T>(init), simd<T>(experimental::reduce(acc[0], reduce_op))))[0];
+        }
+
+        template <std::contiguous_iterator It, typename T, typename ReduceOp,
+            typename TransformOp>
+        inline T transform_reduce(It first, It last, T init,
+            ReduceOp reduce_op, TransformOp transform_op)
+        {
+            return algorithms::transform_reduce(
+                std::span(first, last), init, reduce_op, transform_op);
+        }
+
+        // reduce_op over the range and init, std::plus by default
+        template <std::ranges::contiguous_range In, typename T,
+            typename ReduceOp = std::plus<>>
+        inline T reduce(In&& in, T init, ReduceOp reduce_op = {})
+        {
+            return algorithms::transform_reduce(std::forward<In>(in), init,
+                reduce_op, [](const auto& x) { return x; });
+        }
+
+        template <std::contiguous_iterator It, typename T,
+            typename ReduceOp = std::plus<>>
+        inline T reduce(It first, It last, T init, ReduceOp reduce_op = {})
+        {
+            return algorithms::reduce(std::span(first, last), init, reduce_op);
+        }
+    }    // namespace algorithms
+
+    using algorithms::copy_if;
+    using algorithms::count;
+    using algorithms::count_if;
+    using algorithms::find;
+    using algorithms::find_if;
+    using algorithms::lower_bound_many;
+    using algorithms::mismatch;
+    using algorithms::partition;
+    using algorithms::partition_copy;
+    using algorithms::reduce;
+    using algorithms::remove_if;
+    using algorithms::transform_reduce;
+}    // namespace rvv
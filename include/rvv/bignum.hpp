@@ -0,0 +1,247 @@
+#pragma once
+
+#include <rvv/rvv.hpp>
+#include <algorithm>
+#include <cstdint>
+
+// Batched multi-precision unsigned integer arithmetic.
+//
+// A batch holds `count` numbers of Limbs limbs each, least significant limb
+// first, stored limb major: limb i of number j is at p[i * count + j]. Every
+// vector lane works on its own number, so the carries run through the
+// masks of add_with_carry and sub_with_borrow (vadc/vmadc, vsbc/vmsbc)
+// instead of a scalar carry chain and a vector register of numbers is
+// processed per pass. Limbs are uint32_t or uint64_t.
+
+namespace rvv {
+
+    namespace bignum_impl {
+
+        using namespace rvv::experimental;
+
+        template <typename T>
+        inline simd<T> load(const T* p, size_t vl)
+        {
+            simd<T> x;
+            x.partial_copy_from(p, vl);
+            return x;
+        }
+
+        // 1 where c is set, 0 elsewhere
+        template <typename T>
+        inline simd<T> digit(const simd_mask<T>& c)
+        {
+            return choose(c, simd<T>(T(1)), simd<T>(T(0)));
+        }
+
+        // (carry, t) = t + x * y + carry, the new carry is at most 2^w - 1
+        template <typename T>
+        inline void multiply_add(
+            simd<T>& t, simd<T>& carry, const simd<T>& x, const simd<T>& y)
+        {
+            const simd<T> zero(T(0));
+            const simd_mask<T> none;
+            simd_mask<T> c1, c2, unused;
+            const simd<T> lo = x * y;
+            const simd<T> hi = mulhi(x, y);
+            t = add_with_carry(t, lo, none, c1);
+            t = add_with_carry(t, carry, none, c2);
+            carry = add_with_carry(
+                add_with_carry(hi, zero, c1, unused), zero, c2, unused);
+        }
+
+        // t - m where t has one extra limb t[Limbs] that is 0 or 1, keeps t
+        // when it is already below m
+        template <typename T, size_t Limbs>
+        inline void reduce_once(simd<T>* t, const T* m)
+        {
+            simd<T> difference[Limbs];
+            simd_mask<T> borrow;
+            for (size_t i = 0; i < Limbs; i++)
+                difference[i] = sub_with_borrow(t[i], simd<T>(m[i]), borrow, borrow);
+            // t >= m unless the subtraction borrowed past the extra limb
+            const auto keep = borrow && t[Limbs] == simd<T>(T(0));
+            for (size_t i = 0; i < Limbs; i++)
+                t[i] = choose(keep, t[i], difference[i]);
+        }
+    }    // namespace bignum_impl
+
+    namespace bignum {
+
+        // -m^-1 mod 2^w for an odd m, by Newton iteration: every step doubles
+        // the number of correct low bits of the inverse
+        template <typename T>
+        constexpr T montgomery_factor(T m)
+        {
+            T inverse = m;    // correct to 3 bits for odd m
+            for (int i = 0; i < 5; i++)
+                inverse *= T(2) - m * inverse;
+            return T(0) - inverse;
+        }
+
+        // r = a + b, carry (if not null) receives the carry out of every
+        // number as 0 or 1
+        template <size_t Limbs, typename T>
+        inline void add(const T* a, const T* b, T* r, size_t count, T* carry = nullptr)
+        {
+            using namespace bignum_impl;
+            constexpr size_t N = simd<T>::size();
+            for (size_t j = 0; j < count; j += N)
+            {
+                const size_t vl = std::min(N, count - j);
+                simd_mask<T> c;
+                for (size_t i = 0; i < Limbs; i++)
+                    add_with_carry(load(a + i * count + j, vl),
+                        load(b + i * count + j, vl), c, c)
+                        .partial_copy_to(r + i * count + j, vl);
+                if (carry)
+                    digit(c).partial_copy_to(carry + j, vl);
+            }
+        }
+
+        // r = a - b, borrow (if not null) receives the borrow out of every
+        // number as 0 or 1
+        template <size_t Limbs, typename T>
+        inline void sub(const T* a, const T* b, T* r, size_t count, T* borrow = nullptr)
+        {
+            using namespace bignum_impl;
+            constexpr size_t N = simd<T>::size();
+            for (size_t j = 0; j < count; j += N)
+            {
+                const size_t vl = std::min(N, count - j);
+                simd_mask<T> c;
+                for (size_t i = 0; i < Limbs; i++)
+                    sub_with_borrow(load(a + i * count + j, vl),
+                        load(b + i * count + j, vl), c, c)
+                        .partial_copy_to(r + i * count + j, vl);
+                if (borrow)
+                    digit(c).partial_copy_to(borrow + j, vl);
+            }
+        }
+
+        // r = (a + b) mod m for a, b < m, m is a single Limbs limb modulus
+        // shared by the batch
+        template <size_t Limbs, typename T>
+        inline void add_mod(const T* a, const T* b, const T* m, T* r, size_t count)
+        {
+            using namespace bignum_impl;
+            constexpr size_t N = simd<T>::size();
+            for (size_t j = 0; j < count; j += N)
+            {
+                const size_t vl = std::min(N, count - j);
+                simd<T> t[Limbs + 1];
+                simd_mask<T> c;
+                for (size_t i = 0; i < Limbs; i++)
+                    t[i] = add_with_carry(load(a + i * count + j, vl),
+                        load(b + i * count + j, vl), c, c);
+                t[Limbs] = digit(c);
+                reduce_once<T, Limbs>(t, m);
+                for (size_t i = 0; i < Limbs; i++)
+                    t[i].partial_copy_to(r + i * count + j, vl);
+            }
+        }
+
+        // r = (a - b) mod m for a, b < m
+        template <size_t Limbs, typename T>
+        inline void sub_mod(const T* a, const T* b, const T* m, T* r, size_t count)
+        {
+            using namespace bignum_impl;
+            constexpr size_t N = simd<T>::size();
+            for (size_t j = 0; j < count; j += N)
+            {
+                const size_t vl = std::min(N, count - j);
+                simd<T> t[Limbs];
+                simd_mask<T> c;
+                for (size_t i = 0; i < Limbs; i++)
+                    t[i] = sub_with_borrow(load(a + i * count + j, vl),
+                        load(b + i * count + j, vl), c, c);
+                // add m back where the difference went negative
+                const simd_mask<T> negative = c;
+                c = simd_mask<T>();
+                for (size_t i = 0; i < Limbs; i++)
+                {
+                    const simd<T> y =
+                        choose(negative, simd<T>(m[i]), simd<T>(T(0)));
+                    add_with_carry(t[i], y, c, c)
+                        .partial_copy_to(r + i * count + j, vl);
+                }
+            }
+        }
+
+        // r = a * b, r has 2 * Limbs limbs (stride count like the inputs)
+        template <size_t Limbs, typename T>
+        inline void multiply(const T* a, const T* b, T* r, size_t count)
+        {
+            using namespace bignum_impl;
+            constexpr size_t N = simd<T>::size();
+            for (size_t j = 0; j < count; j += N)
+            {
+                const size_t vl = std::min(N, count - j);
+                simd<T> x[Limbs], t[2 * Limbs];
+                for (size_t i = 0; i < Limbs; i++)
+                    x[i] = load(a + i * count + j, vl);
+                for (size_t i = 0; i < 2 * Limbs; i++)
+                    t[i] = simd<T>(T(0));
+                for (size_t i = 0; i < Limbs; i++)
+                {
+                    const simd<T> y = load(b + i * count + j, vl);
+                    simd<T> carry(T(0));
+                    for (size_t k = 0; k < Limbs; k++)
+                        multiply_add(t[i + k], carry, x[k], y);
+                    t[i + Limbs] = carry;
+                }
+                for (size_t i = 0; i < 2 * Limbs; i++)
+                    t[i].partial_copy_to(r + i * count + j, vl);
+            }
+        }
+
+        // Montgomery product r = a * b * 2^(-w * Limbs) mod m for a, b < m
+        // and an odd m, factor is montgomery_factor(m[0]). Uses the CIOS
+        // method: each limb of b is multiplied in and the lowest limb is
+        // cleared by adding a multiple of m before shifting down a limb.
+        template <size_t Limbs, typename T>
+        inline void montgomery_multiply(const T* a, const T* b, const T* m,
+            T factor, T* r, size_t count)
+        {
+            using namespace bignum_impl;
+            constexpr size_t N = simd<T>::size();
+            const simd<T> zero(T(0));
+            const simd_mask<T> none;
+            for (size_t j = 0; j < count; j += N)
+            {
+                const size_t vl = std::min(N, count - j);
+                simd<T> x[Limbs], t[Limbs + 2];
+                for (size_t i = 0; i < Limbs; i++)
+                    x[i] = load(a + i * count + j, vl);
+                for (size_t i = 0; i < Limbs + 2; i++)
+                    t[i] = zero;
+
+                for (size_t i = 0; i < Limbs; i++)
+                {
+                    const simd<T> y = load(b + i * count + j, vl);
+                    simd<T> carry = zero;
+                    for (size_t k = 0; k < Limbs; k++)
+                        multiply_add(t[k], carry, x[k], y);
+                    simd_mask<T> c;
+                    t[Limbs] = add_with_carry(t[Limbs], carry, none, c);
+                    t[Limbs + 1] = digit(c);
+
+                    // t + q * m is divisible by 2^w
+                    const simd<T> q = t[0] * simd<T>(factor);
+                    carry = zero;
+                    multiply_add(t[0], carry, q, simd<T>(m[0]));
+                    for (size_t k = 1; k < Limbs; k++)
+                    {
+                        multiply_add(t[k], carry, q, simd<T>(m[k]));
+                        t[k - 1] = t[k];
+                    }
+                    t[Limbs - 1] = add_with_carry(t[Limbs], carry, none, c);
+                    t[Limbs] = add_with_carry(t[Limbs + 1], zero, c, c);
+                }
+                reduce_once<T, Limbs>(t, m);
+                for (size_t i = 0; i < Limbs; i++)
+                    t[i].partial_copy_to(r + i * count + j, vl);
+            }
+        }
+    }    // namespace bignum
+}    // namespace rvv
@@ -0,0 +1,438 @@
+#pragma once
+
+#include <rvv/rvv.hpp>
+#include <rvv/algorithms.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+// Dense linear algebra on float and double vectors and row major matrices.
+//
+// The level 1 and 2 routines take an element increment per vector, as in
+// the reference BLAS: a negative increment walks the vector from the last
+// element in memory to the first. Unit increments use contiguous loads, the
+// others strided ones. Sums are spread over several accumulators and
+// reduced across lanes once at the end.
+//
+// gemm follows the usual packed layout: B is copied in blocks of kc rows and
+// nc columns into panels of nr columns, A in blocks of mc rows and kc
+// columns into panels of mr rows, both laid out in the order the
+// micro-kernel reads them. The micro-kernel keeps an mr x nr block of C in
+// mr * nr_vectors registers and, for every k, broadcasts one value of A per
+// row against nr_vectors registers of B. The block sizes keep an A and a B
+// micro-panel in L1 and the packed A block in L2.
+
+namespace rvv::blas {
+
+    namespace blas_impl {
+
+        using namespace rvv::experimental;
+
+        template <typename T>
+        inline constexpr bool is_real =
+            std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+        // micro-kernel shape, mr * nr_vectors accumulators and nr_vectors
+        // registers of B out of the 32 vector registers
+        inline constexpr std::size_t mr = 8;
+        inline constexpr std::size_t nr_vectors = 2;
+        template <typename T>
+        inline constexpr std::size_t nr = nr_vectors * simd<T>::size();
+
+        // rows of A per pass over x in gemv
+        inline constexpr std::size_t gemv_rows = 4;
+
+        // cache blocking
+        inline constexpr std::size_t kc = 256;
+        inline constexpr std::size_t mc = 128;
+        inline constexpr std::size_t nc = 2048;
+
+        inline constexpr std::size_t round_up(std::size_t x, std::size_t m)
+        {
+            return (x + m - 1) / m * m;
+        }
+
+        // element 0 of a vector of n elements with increment inc
+        template <typename T>
+        inline T* first(T* p, std::size_t n, std::ptrdiff_t inc)
+        {
+            return inc < 0 ? p - std::ptrdiff_t(n - 1) * inc : p;
+        }
+
+        // element i of a vector with increment inc
+        template <typename T>
+        inline T* at(T* p, std::size_t i, std::ptrdiff_t inc)
+        {
+            return p + std::ptrdiff_t(i) * inc;
+        }
+
+        // n elements from p with increment inc, the lanes past n are 0
+        template <typename T>
+        inline simd<T> load(const T* p, std::ptrdiff_t inc, std::size_t n)
+        {
+            simd<T> x;
+            if (inc == 1)
+                x.partial_copy_from(p, n);
+            else
+                x.strided_copy_from(p, inc, n);
+            if (n < simd<T>::size())
+                x = choose(algorithms_impl::first_lanes<T>(n), x, simd<T>(T(0)));
+            return x;
+        }
+
+        template <typename T>
+        inline void store(
+            const simd<T>& x, T* p, std::ptrdiff_t inc, std::size_t n)
+        {
+            if (inc == 1)
+                x.partial_copy_to(p, n);
+            else
+                x.strided_copy_to(p, inc, n);
+        }
+
+        // calls step(i, count) for chunks of simd<T>::size() elements, count
+        // is smaller only for the last chunk
+        template <typename T, typename Step>
+        inline void chunks(std::size_t n, Step&& step)
+        {
+            constexpr std::size_t N = simd<T>::size();
+            algorithms_impl::strip_mine<N>(
+                n, [&](std::size_t i) { step(i, N); }, step);
+        }
+
+        // Sums the vectors term(i, count) of the chunks, term returns 0 in
+        // the lanes past count
+        template <typename T, typename Term>
+        inline T sum(std::size_t n, Term&& term)
+        {
+            constexpr std::size_t N = simd<T>::size();
+            constexpr std::size_t K = algorithms_impl::accumulators<T>;
+            std::array<simd<T>, K> acc;
+            for (auto& x : acc)
+                x = simd<T>(T(0));
+            std::size_t i = 0;
+            for (; i + K * N <= n; i += K * N)
+            {
+                [&]<std::size_t... k>(std::index_sequence<k...>) {
+                    ((acc[k] += term(i + k * N, N)), ...);
+                }(std::make_index_sequence<K>{});
+            }
+            for (std::size_t k = 0; i < n; i += N, k++)
+                acc[k] += term(i, std::min(N, n - i));
+            for (std::size_t step = 1; step < K; step *= 2)
+                for (std::size_t k = 0; k + step < K; k += 2 * step)
+                    acc[k] += acc[k + step];
+            return reduce(acc[0]);
+        }
+
+        template <typename T>
+        inline T amax(std::size_t n, const T* x, std::ptrdiff_t incx)
+        {
+            simd<T> m(T(0));
+            chunks<T>(n, [&](std::size_t i, std::size_t count) {
+                m = max(m, abs(load(at(x, i, incx), incx, count)));
+            });
+            return reduce(m, [](auto a, auto b) { return max(a, b); });
+        }
+
+        // kb x nb block of B into panels of nr columns, zero padded
+        template <typename T>
+        inline void pack_b(std::size_t kb, std::size_t nb, const T* b,
+            std::size_t ldb, T* packed)
+        {
+            constexpr std::size_t N = simd<T>::size();
+            for (std::size_t j = 0; j < nb; j += nr<T>)
+            {
+                const std::size_t cols = std::min(nr<T>, nb - j);
+                for (std::size_t p = 0; p < kb; p++, packed += nr<T>)
+                {
+                    const T* row = b + p * ldb + j;
+                    if (cols == nr<T>)
+                    {
+                        for (std::size_t v = 0; v < nr_vectors; v++)
+                            simd<T>(row + v * N, element_aligned)
+                                .copy_to(packed + v * N, element_aligned);
+                    }
+                    else
+                    {
+                        std::copy(row, row + cols, packed);
+                        std::fill(packed + cols, packed + nr<T>, T(0));
+                    }
+                }
+            }
+        }
+
+        // mb x kb block of A into panels of mr rows, column by column, zero
+        // padded
+        template <typename T>
+        inline void pack_a(std::size_t mb, std::size_t kb, const T* a,
+            std::size_t lda, T* packed)
+        {
+            for (std::size_t i = 0; i < mb; i += mr)
+            {
+                const std::size_t rows = std::min(mr, mb - i);
+                for (std::size_t p = 0; p < kb; p++, packed += mr)
+                {
+                    for (std::size_t r = 0; r < rows; r++)
+                        packed[r] = a[(i + r) * lda + p];
+                    std::fill(packed + rows, packed + mr, T(0));
+                }
+            }
+        }
+
+        // c[rows x cols] += alpha * a_panel * b_panel
+        template <typename T>
+        inline void kernel(std::size_t kb, const T* a, const T* b, T* c,
+            std::size_t ldc, std::size_t rows, std::size_t cols, T alpha)
+        {
+            constexpr std::size_t N = simd<T>::size();
+            std::array<simd<T>, mr * nr_vectors> acc;
+            for (auto& x : acc)
+                x = simd<T>(T(0));
+            for (std::size_t p = 0; p < kb; p++, a += mr, b += nr<T>)
+            {
+                std::array<simd<T>, nr_vectors> y;
+                for (std::size_t v = 0; v < nr_vectors; v++)
+                    y[v] = simd<T>(b + v * N, element_aligned);
+                for (std::size_t r = 0; r < mr; r++)
+                {
+                    const simd<T> x(a[r]);
+                    for (std::size_t v = 0; v < nr_vectors; v++)
+                        acc[r * nr_vectors + v] =
+                            fma(x, y[v], acc[r * nr_vectors + v]);
+                }
+            }
+            for (std::size_t r = 0; r < rows; r++)
+            {
+                for (std::size_t v = 0; v < nr_vectors && v * N < cols; v++)
+                {
+                    T* out = c + r * ldc + v * N;
+                    const std::size_t n = std::min(N, cols - v * N);
+                    simd<T> z;
+                    z.partial_copy_from(out, n);
+                    z = fma(simd<T>(alpha), acc[r * nr_vectors + v], z);
+                    z.partial_copy_to(out, n);
+                }
+            }
+        }
+    }    // namespace blas_impl
+
+    // y = alpha * x + y
+    template <typename T>
+    inline void axpy(std::size_t n, T alpha, const T* x, std::ptrdiff_t incx,
+        T* y, std::ptrdiff_t incy)
+    {
+        using namespace blas_impl;
+        static_assert(is_real<T>, "axpy only works for float and double");
+        x = first(x, n, incx);
+        y = first(y, n, incy);
+        const simd<T> a(alpha);
+        chunks<T>(n, [&](std::size_t i, std::size_t count) {
+            T* out = at(y, i, incy);
+            store(fma(a, load(at(x, i, incx), incx, count), load(out, incy, count)),
+                out, incy, count);
+        });
+    }
+
+    // x = alpha * x
+    template <typename T>
+    inline void scal(std::size_t n, T alpha, T* x, std::ptrdiff_t incx)
+    {
+        using namespace blas_impl;
+        static_assert(is_real<T>, "scal only works for float and double");
+        x = first(x, n, incx);
+        chunks<T>(n, [&](std::size_t i, std::size_t count) {
+            T* p = at(x, i, incx);
+            store(load(p, incx, count) * alpha, p, incx, count);
+        });
+    }
+
+    template <typename T>
+    inline T dot(std::size_t n, const T* x, std::ptrdiff_t incx, const T* y,
+        std::ptrdiff_t incy)
+    {
+        using namespace blas_impl;
+        static_assert(is_real<T>, "dot only works for float and double");
+        x = first(x, n, incx);
+        y = first(y, n, incy);
+        return sum<T>(n, [&](std::size_t i, std::size_t count) {
+            return load(at(x, i, incx), incx, count) *
+                load(at(y, i, incy), incy, count);
+        });
+    }
+
+    // sum of the absolute values
+    template <typename T>
+    inline T asum(std::size_t n, const T* x, std::ptrdiff_t incx)
+    {
+        using namespace blas_impl;
+        static_assert(is_real<T>, "asum only works for float and double");
+        x = first(x, n, incx);
+        return sum<T>(n, [&](std::size_t i, std::size_t count) {
+            return abs(load(at(x, i, incx), incx, count));
+        });
+    }
+
+    // Euclidean norm without overflow or underflow in the intermediate sum.
+    // The plain sum of squares is used when it is large enough that lost
+    // tiny squares do not matter and finite, otherwise the elements are
+    // scaled by the largest magnitude and summed again.
+    template <typename T>
+    inline T nrm2(std::size_t n, const T* x, std::ptrdiff_t incx)
+    {
+        using namespace blas_impl;
+        static_assert(is_real<T>, "nrm2 only works for float and double");
+        using limits = std::numeric_limits<T>;
+        x = first(x, n, incx);
+        const T squares = sum<T>(n, [&](std::size_t i, std::size_t count) {
+            simd<T> v = load(at(x, i, incx), incx, count);
+            return v * v;
+        });
+        if (std::isnan(squares) ||
+            (squares <= limits::max() &&
+                squares >= limits::min() / limits::epsilon()))
+            return std::sqrt(squares);
+
+        const T scale = amax(n, x, incx);
+        if (scale == T(0) || std::isinf(scale))
+            return scale;
+        const simd<T> inverse(T(1) / scale);
+        const T scaled = sum<T>(n, [&](std::size_t i, std::size_t count) {
+            simd<T> v = load(at(x, i, incx), incx, count) * inverse;
+            return v * v;
+        });
+        return scale * std::sqrt(scaled);
+    }
+
+    // index of the first element of largest absolute value, 0 if n is 0
+    template <typename T>
+    inline std::size_t iamax(std::size_t n, const T* x, std::ptrdiff_t incx)
+    {
+        using namespace blas_impl;
+        static_assert(is_real<T>, "iamax only works for float and double");
+        x = first(x, n, incx);
+        const simd<T> m(amax(n, x, incx));
+        constexpr std::size_t N = simd<T>::size();
+        for (std::size_t i = 0; i < n; i += N)
+        {
+            const std::size_t count = std::min(N, n - i);
+            int k = find_first_set((abs(load(at(x, i, incx), incx, count)) == m) &&
+                algorithms_impl::first_lanes<T>(count));
+            if (k >= 0)
+                return i + k;
+        }
+        return 0;
+    }
+
+    // y = alpha * A * x + beta * y with A m x n, row major with leading
+    // dimension lda. y is not read when beta is 0.
+    template <typename T>
+    inline void gemv(std::size_t m, std::size_t n, T alpha, const T* a,
+        std::size_t lda, const T* x, std::ptrdiff_t incx, T beta, T* y,
+        std::ptrdiff_t incy)
+    {
+        using namespace blas_impl;
+        static_assert(is_real<T>, "gemv only works for float and double");
+        x = first(x, n, incx);
+        y = first(y, m, incy);
+        // rows are taken gemv_rows at a time to share the loads of x
+        auto rows = [&]<std::size_t R>(std::size_t i,
+                        std::integral_constant<std::size_t, R>) {
+            std::array<simd<T>, R> acc;
+            for (auto& v : acc)
+                v = simd<T>(T(0));
+            chunks<T>(n, [&](std::size_t j, std::size_t count) {
+                const simd<T> v = load(at(x, j, incx), incx, count);
+                for (std::size_t r = 0; r < R; r++)
+                    acc[r] = fma(load(a + (i + r) * lda + j, 1, count), v, acc[r]);
+            });
+            for (std::size_t r = 0; r < R; r++)
+            {
+                T& out = *at(y, i + r, incy);
+                const T ax = alpha * reduce(acc[r]);
+                out = beta == T(0) ? ax : ax + beta * out;
+            }
+        };
+        std::size_t i = 0;
+        for (; i + gemv_rows <= m; i += gemv_rows)
+            rows(i, std::integral_constant<std::size_t, gemv_rows>{});
+        for (; i < m; i++)
+            rows(i, std::integral_constant<std::size_t, 1>{});
+    }
+
+    // A = alpha * x * y^T + A with A m x n, row major with leading dimension
+    // lda
+    template <typename T>
+    inline void ger(std::size_t m, std::size_t n, T alpha, const T* x,
+        std::ptrdiff_t incx, const T* y, std::ptrdiff_t incy, T* a,
+        std::size_t lda)
+    {
+        using namespace blas_impl;
+        static_assert(is_real<T>, "ger only works for float and double");
+        x = first(x, m, incx);
+        for (std::size_t i = 0; i < m; i++)
+            blas::axpy(n, alpha * *at(x, i, incx), y, incy,
+                a + i * lda, 1);
+    }
+
+    // C = alpha * A * B + beta * C with A m x k, B k x n and C m x n, row
+    // major with leading dimensions lda, ldb and ldc. C is not read when
+    // beta is 0.
+    template <typename T>
+    inline void gemm(std::size_t m, std::size_t n, std::size_t k, T alpha,
+        const T* a, std::size_t lda, const T* b, std::size_t ldb, T beta, T* c,
+        std::size_t ldc)
+    {
+        using namespace blas_impl;
+        static_assert(is_real<T>, "gemm only works for float and double");
+        using simd_t = rvv::experimental::simd<T>;
+
+        if (beta != T(1))
+        {
+            for (std::size_t i = 0; i < m; i++)
+            {
+                const std::span row(c + i * ldc, n);
+                if (beta == T(0))
+                    algorithms::fill(row, T(0));
+                else
+                    algorithms::for_each(row, [=](simd_t& x) { x *= beta; });
+            }
+        }
+        if (m == 0 || n == 0 || k == 0 || alpha == T(0))
+            return;
+
+        std::vector<T> packed_b(
+            std::min(kc, k) * round_up(std::min(nc, n), nr<T>));
+        std::vector<T> packed_a(round_up(std::min(mc, m), mr) * std::min(kc, k));
+        for (std::size_t jc = 0; jc < n; jc += nc)
+        {
+            const std::size_t nb = std::min(nc, n - jc);
+            for (std::size_t pc = 0; pc < k; pc += kc)
+            {
+                const std::size_t kb = std::min(kc, k - pc);
+                pack_b(kb, nb, b + pc * ldb + jc, ldb, packed_b.data());
+                for (std::size_t ic = 0; ic < m; ic += mc)
+                {
+                    const std::size_t mb = std::min(mc, m - ic);
+                    pack_a(mb, kb, a + ic * lda + pc, lda, packed_a.data());
+                    for (std::size_t jr = 0; jr < nb; jr += nr<T>)
+                    {
+                        for (std::size_t ir = 0; ir < mb; ir += mr)
+                        {
+                            kernel(kb, packed_a.data() + ir * kb,
+                                packed_b.data() + jr * kb,
+                                c + (ic + ir) * ldc + jc + jr, ldc,
+                                std::min(mr, mb - ir), std::min(nr<T>, nb - jr),
+                                alpha);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}    // namespace rvv::blas
@@ -0,0 +1,311 @@
+#pragma once
+
+#include <rvv/rvv.hpp>
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+// CRC32 (zlib, IEEE 802.3), CRC32C (Castagnoli) and GHASH (GCM).
+//
+// With Zvbc the bulk of the input is folded with carry-less multiplies over
+// all 64-bit lanes of a vector register and only the last block is handed
+// to the scalar code. Without Zvbc the CRCs use a slicing-by-8 table and
+// GHASH a software carry-less multiply.
+
+namespace rvv {
+
+    namespace checksum_impl {
+
+        // number of 64-bit lanes in a vector register
+        inline constexpr size_t lanes = RVV_LEN / 64;
+
+        // bit-reflected CRC polynomials, bit i is the coefficient of x^(31-i)
+        inline constexpr uint32_t crc32_polynomial = 0xedb88320;
+        inline constexpr uint32_t crc32c_polynomial = 0x82f63b78;
+
+        // x^n mod P in the reflected representation
+        constexpr uint32_t xpow_mod(size_t n, uint32_t polynomial)
+        {
+            uint32_t r = 0x80000000;
+            for (size_t i = 0; i < n; i++)
+                r = (r >> 1) ^ ((r & 1) ? polynomial : 0);
+            return r;
+        }
+
+        // tables for slicing-by-8, table[k][b] is the crc of byte b followed
+        // by k zero bytes
+        template <uint32_t Polynomial>
+        struct crc_tables
+        {
+            static constexpr std::array<std::array<uint32_t, 256>, 8> make()
+            {
+                std::array<std::array<uint32_t, 256>, 8> t{};
+                for (uint32_t i = 0; i < 256; i++)
+                {
+                    uint32_t c = i;
+                    for (int k = 0; k < 8; k++)
+                        c = (c >> 1) ^ ((c & 1) ? Polynomial : 0);
+                    t[0][i] = c;
+                }
+                for (int k = 1; k < 8; k++)
+                    for (uint32_t i = 0; i < 256; i++)
+                        t[k][i] = (t[k - 1][i] >> 8) ^ t[0][t[k - 1][i] & 0xff];
+                return t;
+            }
+
+            static constexpr std::array<std::array<uint32_t, 256>, 8> table =
+                make();
+        };
+
+        // Table driven update of the (non inverted) crc register
+        template <uint32_t Polynomial>
+        inline uint32_t crc_scalar(uint32_t crc, const uint8_t* p, size_t size)
+        {
+            const auto& t = crc_tables<Polynomial>::table;
+            for (; size >= 8; p += 8, size -= 8)
+            {
+                uint64_t w;
+                std::memcpy(&w, p, 8);
+                w ^= crc;
+                crc = t[7][w & 0xff] ^ t[6][(w >> 8) & 0xff] ^
+                    t[5][(w >> 16) & 0xff] ^ t[4][(w >> 24) & 0xff] ^
+                    t[3][(w >> 32) & 0xff] ^ t[2][(w >> 40) & 0xff] ^
+                    t[1][(w >> 48) & 0xff] ^ t[0][w >> 56];
+            }
+            for (; size > 0; p++, size--)
+                crc = (crc >> 8) ^ t[0][(crc ^ *p) & 0xff];
+            return crc;
+        }
+
+        // Fold the input into one vector of 64-bit words that has the same
+        // crc as the input, then finish that block with the scalar code.
+        //
+        // A little endian 64-bit word holds 64 message bits with bit i the
+        // coefficient of x^(63-i). Advancing a word by one vector block
+        // multiplies it by x^(64 * lanes); its two 32-bit halves are
+        // multiplied by the precomputed x^(64 * lanes + 32) mod P and
+        // x^(64 * lanes) mod P instead, which keeps each product within 63
+        // bits. The constants are shifted left by one to align the reflected
+        // products to 64 bits.
+        template <uint32_t Polynomial>
+        inline uint32_t crc_update(uint32_t crc, const uint8_t* p, size_t size)
+        {
+#if defined(__riscv_zvbc)
+            constexpr size_t block = lanes * 8;
+            if (size >= 2 * block)
+            {
+                constexpr uint64_t k_first =
+                    uint64_t(xpow_mod(64 * lanes + 32, Polynomial)) << 1;
+                constexpr uint64_t k_second =
+                    uint64_t(xpow_mod(64 * lanes, Polynomial)) << 1;
+                auto k_first_vec = __riscv_vmv_v_x_u64m1(k_first, lanes);
+                auto k_second_vec = __riscv_vmv_v_x_u64m1(k_second, lanes);
+
+                // the crc register is added to the first 32 message bits
+                alignas(16) uint8_t buffer[block];
+                std::memcpy(buffer, p, block);
+                for (int i = 0; i < 4; i++)
+                    buffer[i] ^= uint8_t(crc >> (8 * i));
+                auto load = [](const uint8_t* q) {
+                    return rvv_impl::reinterpret<uint64_t, uint8_t>(
+                        __riscv_vle8_v_u8m1(q, block));
+                };
+
+                auto acc = load(buffer);
+                for (p += block, size -= block; size >= block;
+                     p += block, size -= block)
+                {
+                    // first 32 message bits are the low half of each word
+                    auto first = __riscv_vand(acc, 0xffffffff, lanes);
+                    auto second = __riscv_vsrl(acc, 32, lanes);
+                    acc = __riscv_vxor(
+                        rvv_impl::clmul(first, k_first_vec, lanes),
+                        rvv_impl::clmul(second, k_second_vec, lanes), lanes);
+                    acc = __riscv_vxor(acc, load(p), lanes);
+                }
+
+                __riscv_vse8(buffer,
+                    rvv_impl::reinterpret<uint8_t, uint64_t>(acc), block);
+                crc = crc_scalar<Polynomial>(0, buffer, block);
+            }
+#endif
+            return crc_scalar<Polynomial>(crc, p, size);
+        }
+
+        // GF(2^128) element of GHASH, lo holds the coefficients of
+        // x^0..x^63 and hi those of x^64..x^127
+        struct ghash_block
+        {
+            uint64_t lo;
+            uint64_t hi;
+        };
+
+        // GCM numbers the bits of a byte from the most significant one,
+        // reversing the bits of every byte gives little endian words
+        inline uint64_t reverse_byte_bits(uint64_t w)
+        {
+            uint64_t r = 0;
+            for (int i = 0; i < 8; i++)
+            {
+                uint8_t b = uint8_t(w >> (8 * i));
+                b = uint8_t((rvv_impl::nibble_reverse[b & 0xf] << 4) |
+                    rvv_impl::nibble_reverse[b >> 4]);
+                r |= uint64_t(b) << (8 * i);
+            }
+            return r;
+        }
+
+        inline ghash_block load_block(const uint8_t* p)
+        {
+            ghash_block b;
+            std::memcpy(&b.lo, p, 8);
+            std::memcpy(&b.hi, p + 8, 8);
+            return {reverse_byte_bits(b.lo), reverse_byte_bits(b.hi)};
+        }
+
+        inline void store_block(ghash_block b, uint8_t* p)
+        {
+            uint64_t lo = reverse_byte_bits(b.lo);
+            uint64_t hi = reverse_byte_bits(b.hi);
+            std::memcpy(p, &lo, 8);
+            std::memcpy(p + 8, &hi, 8);
+        }
+
+        inline void clmul_scalar(uint64_t a, uint64_t b, uint64_t& lo, uint64_t& hi)
+        {
+            lo = 0;
+            hi = 0;
+            for (int i = 0; i < 64; i++)
+            {
+                uint64_t mask = 0 - ((b >> i) & 1);
+                lo ^= (a << i) & mask;
+                hi ^= i ? (a >> (64 - i)) & mask : 0;
+            }
+        }
+
+        // reduce p3:p2:p1:p0 modulo x^128 + x^7 + x^2 + x + 1
+        inline ghash_block reduce(uint64_t p0, uint64_t p1, uint64_t p2, uint64_t p3)
+        {
+            uint64_t lo, hi;
+            clmul_scalar(p3, 0x87, lo, hi);
+            p1 ^= lo;
+            p2 ^= hi;
+            clmul_scalar(p2, 0x87, lo, hi);
+            return {p0 ^ lo, p1 ^ hi};
+        }
+
+        inline ghash_block multiply(ghash_block a, ghash_block b)
+        {
+            uint64_t p0, p1, p2, p3, lo, hi;
+            clmul_scalar(a.lo, b.lo, p0, p1);
+            clmul_scalar(a.hi, b.hi, p2, p3);
+            clmul_scalar(a.lo, b.hi, lo, hi);
+            p1 ^= lo;
+            p2 ^= hi;
+            clmul_scalar(a.hi, b.lo, lo, hi);
+            return reduce(p0, p1 ^ lo, p2 ^ hi, p3);
+        }
+
+        // Process whole multiples of `lanes` blocks, lane i multiplies its
+        // block by H^(lanes - i) so that the products of all lanes can be
+        // added before a single reduction:
+        //   Y' = (Y + B_0) H^n + B_1 H^(n-1) + ... + B_(n-1) H
+#if defined(__riscv_zvbc)
+        inline ghash_block ghash_update(
+            ghash_block y, ghash_block h, const uint8_t*& p, size_t& blocks)
+        {
+            if (blocks < lanes)
+                return y;
+
+            alignas(16) uint64_t powers_lo[lanes];
+            alignas(16) uint64_t powers_hi[lanes];
+            ghash_block power = h;
+            for (size_t i = lanes; i-- > 0;)
+            {
+                powers_lo[i] = power.lo;
+                powers_hi[i] = power.hi;
+                power = multiply(power, h);
+            }
+            auto h_lo = __riscv_vle64_v_u64m1(powers_lo, lanes);
+            auto h_hi = __riscv_vle64_v_u64m1(powers_hi, lanes);
+            auto zero = __riscv_vmv_v_x_u64m1(0, lanes);
+            auto xor_lanes = [&](vuint64m1_t v) {
+                return __riscv_vmv_x(__riscv_vredxor(v, zero, lanes));
+            };
+            auto load_words = [](const uint64_t* q) {
+                auto v = __riscv_vlse64_v_u64m1(q, 16, lanes);
+                return rvv_impl::reinterpret<uint64_t, uint8_t>(
+                    rvv_impl::bit_reverse<uint8_t>(
+                        rvv_impl::reinterpret<uint8_t, uint64_t>(v),
+                        lanes * 8));
+            };
+
+            alignas(16) uint64_t buffer[2 * lanes];
+            for (; blocks >= lanes; blocks -= lanes, p += 16 * lanes)
+            {
+                std::memcpy(buffer, p, 16 * lanes);
+                // Y is added to the first block
+                buffer[0] ^= reverse_byte_bits(y.lo);
+                buffer[1] ^= reverse_byte_bits(y.hi);
+                auto a_lo = load_words(buffer);
+                auto a_hi = load_words(buffer + 1);
+
+                auto p0 = rvv_impl::clmul(a_lo, h_lo, lanes);
+                auto p1 = __riscv_vxor(rvv_impl::clmulh(a_lo, h_lo, lanes),
+                    __riscv_vxor(rvv_impl::clmul(a_lo, h_hi, lanes),
+                        rvv_impl::clmul(a_hi, h_lo, lanes), lanes), lanes);
+                auto p2 = __riscv_vxor(rvv_impl::clmul(a_hi, h_hi, lanes),
+                    __riscv_vxor(rvv_impl::clmulh(a_lo, h_hi, lanes),
+                        rvv_impl::clmulh(a_hi, h_lo, lanes), lanes), lanes);
+                auto p3 = rvv_impl::clmulh(a_hi, h_hi, lanes);
+                y = reduce(xor_lanes(p0), xor_lanes(p1), xor_lanes(p2),
+                    xor_lanes(p3));
+            }
+            return y;
+        }
+#endif
+    }    // namespace checksum_impl
+
+    // crc32 as in zlib, pass a previous result as crc to continue it
+    inline uint32_t crc32(const void* data, size_t size, uint32_t crc = 0)
+    {
+        return ~checksum_impl::crc_update<checksum_impl::crc32_polynomial>(
+            ~crc, static_cast<const uint8_t*>(data), size);
+    }
+
+    // crc32c (Castagnoli) as used by iSCSI and ext4
+    inline uint32_t crc32c(const void* data, size_t size, uint32_t crc = 0)
+    {
+        return ~checksum_impl::crc_update<checksum_impl::crc32c_polynomial>(
+            ~crc, static_cast<const uint8_t*>(data), size);
+    }
+
+    // ghash updates the 16 byte GCM hash state y with data under the hash
+    // key h, a trailing partial block is padded with zeros
+    inline void ghash(const uint8_t* h, const void* data, size_t size, uint8_t* y)
+    {
+        using namespace checksum_impl;
+        const uint8_t* p = static_cast<const uint8_t*>(data);
+        const ghash_block key = load_block(h);
+        ghash_block state = load_block(y);
+
+        size_t blocks = size / 16;
+        size_t rest = size % 16;
+#if defined(__riscv_zvbc)
+        state = ghash_update(state, key, p, blocks);
+#endif
+        for (; blocks > 0; blocks--, p += 16)
+        {
+            ghash_block b = load_block(p);
+            state = multiply({state.lo ^ b.lo, state.hi ^ b.hi}, key);
+        }
+        if (rest)
+        {
+            uint8_t last[16] = {};
+            std::memcpy(last, p, rest);
+            ghash_block b = load_block(last);
+            state = multiply({state.lo ^ b.lo, state.hi ^ b.hi}, key);
+        }
+        store_block(state, y);
+    }
+}    // namespace rvv
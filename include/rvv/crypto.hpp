@@ -0,0 +1,730 @@
+#pragma once
+
+#include <rvv/rvv.hpp>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+// AES (FIPS-197) and SHA-2 (FIPS-180-4).
+//
+// With Zvkned an AES round is applied to every 128-bit element group of a
+// vector register, the round key is broadcast from a single group, so the
+// bulk functions work on RVV_LEN / 128 blocks per instruction. With Zvknha
+// (SHA-256) or Zvknhb (SHA-256 and SHA-512) every element group holds the
+// state of an independent message, which the multi-buffer functions use to
+// hash several messages of the same length at once. Without the extensions
+// a byte oriented software implementation with the same results is used.
+
+namespace rvv {
+
+    namespace crypto_impl {
+
+        // number of 128-bit element groups in a vector register
+        inline constexpr size_t groups = RVV_LEN / 128;
+
+        constexpr uint8_t xtime(uint8_t a)
+        {
+            return uint8_t((a << 1) ^ ((a & 0x80) ? 0x1b : 0));
+        }
+
+        constexpr uint8_t gf_multiply(uint8_t a, uint8_t b)
+        {
+            uint8_t r = 0;
+            for (; b; b >>= 1, a = xtime(a))
+                if (b & 1)
+                    r ^= a;
+            return r;
+        }
+
+        // S-box and inverse S-box: the multiplicative inverse in GF(2^8)
+        // followed by the affine transform
+        constexpr std::array<std::array<uint8_t, 256>, 2> make_aes_tables()
+        {
+            // powers and logarithms of the generator 3
+            std::array<uint8_t, 256> power{}, log{};
+            uint8_t x = 1;
+            for (int i = 0; i < 255; i++)
+            {
+                power[i] = x;
+                log[x] = uint8_t(i);
+                x = gf_multiply(x, 3);
+            }
+            std::array<std::array<uint8_t, 256>, 2> t{};
+            for (int i = 0; i < 256; i++)
+            {
+                uint8_t inverse = i ? power[(255 - log[i]) % 255] : 0;
+                uint8_t s = inverse ^ 0x63;
+                for (int k = 1; k < 5; k++)
+                    s ^= uint8_t((inverse << k) | (inverse >> (8 - k)));
+                t[0][i] = s;
+                t[1][s] = uint8_t(i);
+            }
+            return t;
+        }
+
+        inline constexpr std::array<std::array<uint8_t, 256>, 2> aes_tables =
+            make_aes_tables();
+
+        // Software AES on a column major 16 byte state, the same layout the
+        // vector instructions use for an element group
+        inline void sub_bytes(uint8_t* s, bool inverse)
+        {
+            const auto& box = aes_tables[inverse];
+            for (int i = 0; i < 16; i++)
+                s[i] = box[s[i]];
+        }
+
+        inline void shift_rows(uint8_t* s, bool inverse)
+        {
+            uint8_t t[16];
+            for (int c = 0; c < 4; c++)
+                for (int r = 0; r < 4; r++)
+                    t[4 * c + r] = s[4 * ((inverse ? c + 4 - r : c + r) % 4) + r];
+            std::memcpy(s, t, 16);
+        }
+
+        inline void mix_columns(uint8_t* s, bool inverse)
+        {
+            const uint8_t m[4] = {uint8_t(inverse ? 14 : 2),
+                uint8_t(inverse ? 11 : 3), uint8_t(inverse ? 13 : 1),
+                uint8_t(inverse ? 9 : 1)};
+            for (int c = 0; c < 4; c++)
+            {
+                uint8_t a[4];
+                std::memcpy(a, s + 4 * c, 4);
+                for (int r = 0; r < 4; r++)
+                    s[4 * c + r] = gf_multiply(a[r], m[0]) ^
+                        gf_multiply(a[(r + 1) % 4], m[1]) ^
+                        gf_multiply(a[(r + 2) % 4], m[2]) ^
+                        gf_multiply(a[(r + 3) % 4], m[3]);
+            }
+        }
+
+        inline void add_round_key(uint8_t* s, const uint8_t* key)
+        {
+            for (int i = 0; i < 16; i++)
+                s[i] ^= key[i];
+        }
+
+        // FIPS-197 key expansion for a key of key_words 32-bit words
+        inline void expand_key_scalar(const uint8_t* key, size_t key_words,
+            size_t rounds, uint8_t* round_keys)
+        {
+            const auto& box = aes_tables[0];
+            std::memcpy(round_keys, key, 4 * key_words);
+            uint8_t rcon = 1;
+            for (size_t i = key_words; i < 4 * (rounds + 1); i++)
+            {
+                uint8_t t[4];
+                std::memcpy(t, round_keys + 4 * (i - 1), 4);
+                if (i % key_words == 0)
+                {
+                    uint8_t first = t[0];
+                    t[0] = box[t[1]] ^ rcon;
+                    t[1] = box[t[2]];
+                    t[2] = box[t[3]];
+                    t[3] = box[first];
+                    rcon = xtime(rcon);
+                }
+                else if (key_words > 6 && i % key_words == 4)
+                {
+                    for (int j = 0; j < 4; j++)
+                        t[j] = box[t[j]];
+                }
+                for (int j = 0; j < 4; j++)
+                    round_keys[4 * i + j] = round_keys[4 * (i - key_words) + j] ^ t[j];
+            }
+        }
+
+#if defined(__riscv_zvkned)
+        typedef vuint32m1_t aes_vector
+            __attribute__((riscv_rvv_vector_bits(RVV_LEN)));
+
+        inline aes_vector load_blocks(const uint8_t* p, size_t blocks)
+        {
+            return rvv_impl::reinterpret<uint32_t, uint8_t>(
+                __riscv_vle8_v_u8m1(p, 16 * blocks));
+        }
+
+        inline void store_blocks(uint8_t* p, aes_vector v, size_t blocks)
+        {
+            __riscv_vse8(
+                p, rvv_impl::reinterpret<uint8_t, uint32_t>(v), 16 * blocks);
+        }
+
+        // vaeskf1 and vaeskf2 take the round number as an immediate
+        template <unsigned Round>
+        inline void expand_key_128(aes_vector key, uint8_t (*round_keys)[16])
+        {
+            store_blocks(round_keys[Round], key, 1);
+            if constexpr (Round < 10)
+                expand_key_128<Round + 1>(
+                    __riscv_vaeskf1_vi_u32m1(key, Round + 1, 4), round_keys);
+        }
+
+        template <unsigned Round>
+        inline void expand_key_256(
+            aes_vector previous, aes_vector key, uint8_t (*round_keys)[16])
+        {
+            store_blocks(round_keys[Round], key, 1);
+            if constexpr (Round < 14)
+                expand_key_256<Round + 1>(key,
+                    __riscv_vaeskf2_vi_u32m1(previous, key, Round + 1, 4),
+                    round_keys);
+        }
+#endif
+
+        template <size_t Rounds>
+        inline void expand_key(const uint8_t* key, uint8_t (*round_keys)[16])
+        {
+            static_assert(Rounds == 10 || Rounds == 14,
+                "only AES-128 and AES-256 keys are supported");
+#if defined(__riscv_zvkned)
+            if constexpr (Rounds == 10)
+                expand_key_128<0>(load_blocks(key, 1), round_keys);
+            else
+            {
+                store_blocks(round_keys[0], load_blocks(key, 1), 1);
+                expand_key_256<1>(load_blocks(key, 1),
+                    load_blocks(key + 16, 1), round_keys);
+            }
+#else
+            expand_key_scalar(key, Rounds == 10 ? 4 : 8, Rounds, round_keys[0]);
+#endif
+        }
+
+        // Encrypts or decrypts whole blocks, the inverse cipher uses the
+        // encryption round keys in reverse order
+        template <size_t Rounds, bool Decrypt>
+        inline void aes_blocks(const uint8_t (*round_keys)[16],
+            const uint8_t* in, uint8_t* out, size_t blocks)
+        {
+#if defined(__riscv_zvkned)
+            aes_vector keys[Rounds + 1];
+            for (size_t i = 0; i <= Rounds; i++)
+                keys[i] = load_blocks(round_keys[Decrypt ? Rounds - i : i], 1);
+
+            for (; blocks > 0; in += 16 * groups, out += 16 * groups)
+            {
+                const size_t n = std::min(blocks, groups);
+                const size_t vl = 4 * n;
+                aes_vector state = load_blocks(in, n);
+                state = __riscv_vaesz_vs_u32m1_u32m1(state, keys[0], vl);
+                for (size_t i = 1; i < Rounds; i++)
+                {
+                    if constexpr (Decrypt)
+                        state = __riscv_vaesdm_vs_u32m1_u32m1(state, keys[i], vl);
+                    else
+                        state = __riscv_vaesem_vs_u32m1_u32m1(state, keys[i], vl);
+                }
+                if constexpr (Decrypt)
+                    state = __riscv_vaesdf_vs_u32m1_u32m1(state, keys[Rounds], vl);
+                else
+                    state = __riscv_vaesef_vs_u32m1_u32m1(state, keys[Rounds], vl);
+                store_blocks(out, state, n);
+                blocks -= n;
+            }
+#else
+            for (; blocks > 0; blocks--, in += 16, out += 16)
+            {
+                uint8_t s[16];
+                std::memcpy(s, in, 16);
+                add_round_key(s, round_keys[Decrypt ? Rounds : 0]);
+                for (size_t i = 1; i <= Rounds; i++)
+                {
+                    if constexpr (Decrypt)
+                    {
+                        shift_rows(s, true);
+                        sub_bytes(s, true);
+                        add_round_key(s, round_keys[Rounds - i]);
+                        if (i != Rounds)
+                            mix_columns(s, true);
+                    }
+                    else
+                    {
+                        sub_bytes(s, false);
+                        shift_rows(s, false);
+                        if (i != Rounds)
+                            mix_columns(s, false);
+                        add_round_key(s, round_keys[i]);
+                    }
+                }
+                std::memcpy(out, s, 16);
+            }
+#endif
+        }
+
+        // adds one to a 128-bit big endian counter
+        inline void increment_counter(uint8_t* counter)
+        {
+            for (int i = 15; i >= 0 && ++counter[i] == 0; i--)
+                ;
+        }
+
+        template <typename Word>
+        struct sha2_traits;
+
+        template <>
+        struct sha2_traits<uint32_t>
+        {
+            static constexpr size_t rounds = 64;
+            // rotations of Σ0, Σ1 and rotations and shift of σ0, σ1
+            static constexpr int big_sigma[2][3] = {{2, 13, 22}, {6, 11, 25}};
+            static constexpr int small_sigma[2][3] = {{7, 18, 3}, {17, 19, 10}};
+
+            static constexpr std::array<uint32_t, 64> k = {
+                0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+                0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+                0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+                0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+                0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+                0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+                0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+                0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+                0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+                0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+                0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+                0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+                0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
+                0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+                0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+                0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+            };
+
+            static constexpr std::array<uint32_t, 8> initial_state = {
+                0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+            };
+
+#if defined(__riscv_zvknha) || defined(__riscv_zvknhb)
+            static constexpr bool vectorized = true;
+            typedef vuint32m1_t vector
+                __attribute__((riscv_rvv_vector_bits(RVV_LEN)));
+
+            static vector load(const uint32_t* p, size_t vl)
+            {
+                return __riscv_vle32_v_u32m1(p, vl);
+            }
+            static void store(uint32_t* p, vector v, size_t vl)
+            {
+                __riscv_vse32(p, v, vl);
+            }
+            static vector index(size_t vl) { return __riscv_vid_v_u32m1(vl); }
+            static vector schedule(vector vd, vector vs2, vector vs1, size_t vl)
+            {
+                return __riscv_vsha2ms_vv_u32m1(vd, vs2, vs1, vl);
+            }
+            static vector compress_high(
+                vector vd, vector vs2, vector vs1, size_t vl)
+            {
+                return __riscv_vsha2ch_vv_u32m1(vd, vs2, vs1, vl);
+            }
+            static vector compress_low(
+                vector vd, vector vs2, vector vs1, size_t vl)
+            {
+                return __riscv_vsha2cl_vv_u32m1(vd, vs2, vs1, vl);
+            }
+#else
+            static constexpr bool vectorized = false;
+#endif
+        };
+
+        template <>
+        struct sha2_traits<uint64_t>
+        {
+            static constexpr size_t rounds = 80;
+            static constexpr int big_sigma[2][3] = {{28, 34, 39}, {14, 18, 41}};
+            static constexpr int small_sigma[2][3] = {{1, 8, 7}, {19, 61, 6}};
+
+            static constexpr std::array<uint64_t, 80> k = {
+                0x428a2f98d728ae22, 0x7137449123ef65cd,
+                0xb5c0fbcfec4d3b2f, 0xe9b5dba58189dbbc,
+                0x3956c25bf348b538, 0x59f111f1b605d019,
+                0x923f82a4af194f9b, 0xab1c5ed5da6d8118,
+                0xd807aa98a3030242, 0x12835b0145706fbe,
+                0x243185be4ee4b28c, 0x550c7dc3d5ffb4e2,
+                0x72be5d74f27b896f, 0x80deb1fe3b1696b1,
+                0x9bdc06a725c71235, 0xc19bf174cf692694,
+                0xe49b69c19ef14ad2, 0xefbe4786384f25e3,
+                0x0fc19dc68b8cd5b5, 0x240ca1cc77ac9c65,
+                0x2de92c6f592b0275, 0x4a7484aa6ea6e483,
+                0x5cb0a9dcbd41fbd4, 0x76f988da831153b5,
+                0x983e5152ee66dfab, 0xa831c66d2db43210,
+                0xb00327c898fb213f, 0xbf597fc7beef0ee4,
+                0xc6e00bf33da88fc2, 0xd5a79147930aa725,
+                0x06ca6351e003826f, 0x142929670a0e6e70,
+                0x27b70a8546d22ffc, 0x2e1b21385c26c926,
+                0x4d2c6dfc5ac42aed, 0x53380d139d95b3df,
+                0x650a73548baf63de, 0x766a0abb3c77b2a8,
+                0x81c2c92e47edaee6, 0x92722c851482353b,
+                0xa2bfe8a14cf10364, 0xa81a664bbc423001,
+                0xc24b8b70d0f89791, 0xc76c51a30654be30,
+                0xd192e819d6ef5218, 0xd69906245565a910,
+                0xf40e35855771202a, 0x106aa07032bbd1b8,
+                0x19a4c116b8d2d0c8, 0x1e376c085141ab53,
+                0x2748774cdf8eeb99, 0x34b0bcb5e19b48a8,
+                0x391c0cb3c5c95a63, 0x4ed8aa4ae3418acb,
+                0x5b9cca4f7763e373, 0x682e6ff3d6b2b8a3,
+                0x748f82ee5defb2fc, 0x78a5636f43172f60,
+                0x84c87814a1f0ab72, 0x8cc702081a6439ec,
+                0x90befffa23631e28, 0xa4506cebde82bde9,
+                0xbef9a3f7b2c67915, 0xc67178f2e372532b,
+                0xca273eceea26619c, 0xd186b8c721c0c207,
+                0xeada7dd6cde0eb1e, 0xf57d4f7fee6ed178,
+                0x06f067aa72176fba, 0x0a637dc5a2c898a6,
+                0x113f9804bef90dae, 0x1b710b35131c471b,
+                0x28db77f523047d84, 0x32caab7b40c72493,
+                0x3c9ebe0a15c9bebc, 0x431d67c49c100d4c,
+                0x4cc5d4becb3e42b6, 0x597f299cfc657e2a,
+                0x5fcb6fab3ad6faec, 0x6c44198c4a475817,
+            };
+
+            static constexpr std::array<uint64_t, 8> initial_state = {
+                0x6a09e667f3bcc908, 0xbb67ae8584caa73b,
+                0x3c6ef372fe94f82b, 0xa54ff53a5f1d36f1,
+                0x510e527fade682d1, 0x9b05688c2b3e6c1f,
+                0x1f83d9abfb41bd6b, 0x5be0cd19137e2179,
+            };
+
+#if defined(__riscv_zvknhb)
+            // an element group of four 64-bit words spans two registers
+            // when RVV_LEN is 128
+            static constexpr bool vectorized = true;
+            typedef vuint64m2_t vector
+                __attribute__((riscv_rvv_vector_bits(RVV_LEN * 2)));
+
+            static vector load(const uint64_t* p, size_t vl)
+            {
+                return __riscv_vle64_v_u64m2(p, vl);
+            }
+            static void store(uint64_t* p, vector v, size_t vl)
+            {
+                __riscv_vse64(p, v, vl);
+            }
+            static vector index(size_t vl) { return __riscv_vid_v_u64m2(vl); }
+            static vector schedule(vector vd, vector vs2, vector vs1, size_t vl)
+            {
+                return __riscv_vsha2ms_vv_u64m2(vd, vs2, vs1, vl);
+            }
+            static vector compress_high(
+                vector vd, vector vs2, vector vs1, size_t vl)
+            {
+                return __riscv_vsha2ch_vv_u64m2(vd, vs2, vs1, vl);
+            }
+            static vector compress_low(
+                vector vd, vector vs2, vector vs1, size_t vl)
+            {
+                return __riscv_vsha2cl_vv_u64m2(vd, vs2, vs1, vl);
+            }
+#else
+            static constexpr bool vectorized = false;
+#endif
+        };
+
+        template <typename Word>
+        inline Word load_big_endian(const uint8_t* p)
+        {
+            Word w = 0;
+            for (size_t i = 0; i < sizeof(Word); i++)
+                w = (w << 8) | p[i];
+            return w;
+        }
+
+        template <typename Word>
+        inline void store_big_endian(uint8_t* p, Word w)
+        {
+            for (size_t i = 0; i < sizeof(Word); i++)
+                p[i] = uint8_t(w >> (8 * (sizeof(Word) - 1 - i)));
+        }
+
+        template <typename Word>
+        inline void sha2_compress(Word* state, const uint8_t* block)
+        {
+            using traits = sha2_traits<Word>;
+            auto sigma = [](Word x, const int* r, bool shift) {
+                return std::rotr(x, r[0]) ^ std::rotr(x, r[1]) ^
+                    (shift ? x >> r[2] : std::rotr(x, r[2]));
+            };
+
+            Word w[traits::rounds];
+            for (size_t t = 0; t < 16; t++)
+                w[t] = load_big_endian<Word>(block + t * sizeof(Word));
+            for (size_t t = 16; t < traits::rounds; t++)
+                w[t] = sigma(w[t - 2], traits::small_sigma[1], true) + w[t - 7] +
+                    sigma(w[t - 15], traits::small_sigma[0], true) + w[t - 16];
+
+            Word a = state[0], b = state[1], c = state[2], d = state[3];
+            Word e = state[4], f = state[5], g = state[6], h = state[7];
+            for (size_t t = 0; t < traits::rounds; t++)
+            {
+                Word t1 = h + sigma(e, traits::big_sigma[1], false) +
+                    ((e & f) ^ (~e & g)) + traits::k[t] + w[t];
+                Word t2 = sigma(a, traits::big_sigma[0], false) +
+                    ((a & b) ^ (a & c) ^ (b & c));
+                h = g;
+                g = f;
+                f = e;
+                e = d + t1;
+                d = c;
+                c = b;
+                b = a;
+                a = t1 + t2;
+            }
+            state[0] += a;
+            state[1] += b;
+            state[2] += c;
+            state[3] += d;
+            state[4] += e;
+            state[5] += f;
+            state[6] += g;
+            state[7] += h;
+        }
+
+        // Hashes `blocks` whole blocks of each of the `count` messages into
+        // their states, count is at most `groups`.
+        //
+        // Message i lives in element group i. Its state is kept as
+        // {f, e, b, a} and {h, g, d, c} (element 0 first), vsha2cl and
+        // vsha2ch each do two rounds and swap the roles of the two state
+        // registers, vsha2ms computes the next four message words.
+        template <typename Word>
+        inline void sha2_blocks(Word (*state)[8], const uint8_t* const* data,
+            size_t blocks, size_t count)
+        {
+            using traits = sha2_traits<Word>;
+            constexpr size_t block_size = 16 * sizeof(Word);
+
+            if constexpr (traits::vectorized)
+            {
+                using vector = typename traits::vector;
+                const size_t vl = 4 * count;
+                const auto lane = __riscv_vand(traits::index(vl), 3, vl);
+                const auto group_first = __riscv_vmseq(lane, 0, vl);
+
+                alignas(16) Word buffer[4][4 * groups];
+                for (size_t s = 0; s < count; s++)
+                {
+                    const Word* h = state[s];
+                    Word abef[4] = {h[5], h[4], h[1], h[0]};
+                    Word cdgh[4] = {h[7], h[6], h[3], h[2]};
+                    std::memcpy(buffer[0] + 4 * s, abef, sizeof(abef));
+                    std::memcpy(buffer[1] + 4 * s, cdgh, sizeof(cdgh));
+                }
+                vector abef = traits::load(buffer[0], vl);
+                vector cdgh = traits::load(buffer[1], vl);
+
+                for (size_t b = 0; b < blocks; b++)
+                {
+                    // words 4q..4q+3 of every message
+                    for (size_t s = 0; s < count; s++)
+                        for (size_t q = 0; q < 4; q++)
+                            for (size_t j = 0; j < 4; j++)
+                                buffer[q][4 * s + j] = load_big_endian<Word>(
+                                    data[s] + b * block_size +
+                                    (4 * q + j) * sizeof(Word));
+                    vector w[4];
+                    for (size_t q = 0; q < 4; q++)
+                        w[q] = traits::load(buffer[q], vl);
+
+                    const vector abef_saved = abef;
+                    const vector cdgh_saved = cdgh;
+                    for (size_t i = 0; i < traits::rounds / 4; i++)
+                    {
+                        vector k = __riscv_vrgather(
+                            traits::load(traits::k.data() + 4 * i, 4), lane, vl);
+                        vector kw = __riscv_vadd(k, w[i % 4], vl);
+                        cdgh = traits::compress_low(cdgh, abef, kw, vl);
+                        abef = traits::compress_high(abef, cdgh, kw, vl);
+                        if (i < traits::rounds / 4 - 4)
+                        {
+                            // {w[4i+11], w[4i+10], w[4i+9], w[4i+4]}
+                            vector middle = __riscv_vmerge(
+                                w[(i + 2) % 4], w[(i + 1) % 4], group_first, vl);
+                            w[i % 4] = traits::schedule(
+                                w[i % 4], middle, w[(i + 3) % 4], vl);
+                        }
+                    }
+                    abef = __riscv_vadd(abef, abef_saved, vl);
+                    cdgh = __riscv_vadd(cdgh, cdgh_saved, vl);
+                }
+
+                traits::store(buffer[0], abef, vl);
+                traits::store(buffer[1], cdgh, vl);
+                for (size_t s = 0; s < count; s++)
+                {
+                    const Word* abef = buffer[0] + 4 * s;
+                    const Word* cdgh = buffer[1] + 4 * s;
+                    Word* h = state[s];
+                    h[0] = abef[3];
+                    h[1] = abef[2];
+                    h[2] = cdgh[3];
+                    h[3] = cdgh[2];
+                    h[4] = abef[1];
+                    h[5] = abef[0];
+                    h[6] = cdgh[1];
+                    h[7] = cdgh[0];
+                }
+            }
+            else
+            {
+                for (size_t s = 0; s < count; s++)
+                    for (size_t b = 0; b < blocks; b++)
+                        sha2_compress<Word>(state[s], data[s] + b * block_size);
+            }
+        }
+
+        // Pads and hashes `count` messages of `size` bytes each
+        template <typename Word>
+        inline void sha2_hash(const uint8_t* const* data, size_t size,
+            uint8_t* const* digests, size_t count)
+        {
+            using traits = sha2_traits<Word>;
+            constexpr size_t block_size = 16 * sizeof(Word);
+            const size_t blocks = size / block_size;
+            const size_t rest = size % block_size;
+            // 0x80 and the length field of two words follow the message
+            const size_t tail_blocks =
+                rest + 1 + 2 * sizeof(Word) <= block_size ? 1 : 2;
+            const uint64_t bits = uint64_t(size) * 8;
+
+            for (size_t first = 0; first < count; first += groups)
+            {
+                const size_t n = std::min(groups, count - first);
+                Word state[groups][8];
+                uint8_t tails[groups][2 * block_size] = {};
+                const uint8_t* tail_pointers[groups];
+                for (size_t s = 0; s < n; s++)
+                {
+                    std::copy(traits::initial_state.begin(),
+                        traits::initial_state.end(), state[s]);
+                    uint8_t* tail = tails[s];
+                    std::memcpy(tail, data[first + s] + blocks * block_size, rest);
+                    tail[rest] = 0x80;
+                    store_big_endian<uint64_t>(
+                        tail + tail_blocks * block_size - 8, bits);
+                    tail_pointers[s] = tail;
+                }
+
+                sha2_blocks<Word>(state, data + first, blocks, n);
+                sha2_blocks<Word>(state, tail_pointers, tail_blocks, n);
+
+                for (size_t s = 0; s < n; s++)
+                    for (size_t i = 0; i < 8; i++)
+                        store_big_endian<Word>(
+                            digests[first + s] + i * sizeof(Word), state[s][i]);
+            }
+        }
+    }    // namespace crypto_impl
+
+    namespace crypto {
+
+        // expanded AES key, round key i is applied after round i
+        template <size_t Rounds>
+        struct aes_key
+        {
+            alignas(16) uint8_t round_keys[Rounds + 1][16];
+        };
+
+        using aes128_key = aes_key<10>;
+        using aes256_key = aes_key<14>;
+
+        // key points to 16 bytes
+        inline aes128_key aes128_expand_key(const uint8_t* key)
+        {
+            aes128_key k;
+            crypto_impl::expand_key<10>(key, k.round_keys);
+            return k;
+        }
+
+        // key points to 32 bytes
+        inline aes256_key aes256_expand_key(const uint8_t* key)
+        {
+            aes256_key k;
+            crypto_impl::expand_key<14>(key, k.round_keys);
+            return k;
+        }
+
+        // Encrypts whole 16 byte blocks independently (ECB), in and out
+        // may be the same buffer
+        template <size_t Rounds>
+        inline void aes_encrypt(
+            const aes_key<Rounds>& key, const void* in, void* out, size_t blocks)
+        {
+            crypto_impl::aes_blocks<Rounds, false>(key.round_keys,
+                static_cast<const uint8_t*>(in), static_cast<uint8_t*>(out),
+                blocks);
+        }
+
+        template <size_t Rounds>
+        inline void aes_decrypt(
+            const aes_key<Rounds>& key, const void* in, void* out, size_t blocks)
+        {
+            crypto_impl::aes_blocks<Rounds, true>(key.round_keys,
+                static_cast<const uint8_t*>(in), static_cast<uint8_t*>(out),
+                blocks);
+        }
+
+        // CTR mode as in SP 800-38A, encryption and decryption are the same.
+        // counter is the 16 byte initial counter block, incremented as a
+        // 128-bit big endian number and left at the next unused value. A
+        // trailing partial block uses up a whole counter value.
+        template <size_t Rounds>
+        inline void aes_ctr(const aes_key<Rounds>& key, uint8_t* counter,
+            const void* in, void* out, size_t size)
+        {
+            using crypto_impl::groups;
+            const uint8_t* src = static_cast<const uint8_t*>(in);
+            uint8_t* dst = static_cast<uint8_t*>(out);
+
+            // as many counter blocks as one vector register holds
+            alignas(16) uint8_t keystream[16 * groups];
+            while (size > 0)
+            {
+                const size_t bytes = std::min(size, sizeof(keystream));
+                const size_t blocks = (bytes + 15) / 16;
+                for (size_t i = 0; i < blocks; i++)
+                {
+                    std::memcpy(keystream + 16 * i, counter, 16);
+                    crypto_impl::increment_counter(counter);
+                }
+                crypto_impl::aes_blocks<Rounds, false>(
+                    key.round_keys, keystream, keystream, blocks);
+                for (size_t i = 0; i < bytes; i++)
+                    dst[i] = src[i] ^ keystream[i];
+                src += bytes;
+                dst += bytes;
+                size -= bytes;
+            }
+        }
+
+        // digest points to 32 bytes
+        inline void sha256(const void* data, size_t size, uint8_t* digest)
+        {
+            const uint8_t* p = static_cast<const uint8_t*>(data);
+            crypto_impl::sha2_hash<uint32_t>(&p, size, &digest, 1);
+        }
+
+        // Hashes count messages of the same size, RVV_LEN / 128 of them are
+        // processed together
+        inline void sha256_multi(const uint8_t* const* data, size_t size,
+            uint8_t* const* digests, size_t count)
+        {
+            crypto_impl::sha2_hash<uint32_t>(data, size, digests, count);
+        }
+
+        // digest points to 64 bytes
+        inline void sha512(const void* data, size_t size, uint8_t* digest)
+        {
+            const uint8_t* p = static_cast<const uint8_t*>(data);
+            crypto_impl::sha2_hash<uint64_t>(&p, size, &digest, 1);
+        }
+
+        inline void sha512_multi(const uint8_t* const* data, size_t size,
+            uint8_t* const* digests, size_t count)
+        {
+            crypto_impl::sha2_hash<uint64_t>(data, size, digests, count);
+        }
+    }    // namespace crypto
+}    // namespace rvv
@@ -0,0 +1,355 @@
+#pragma once
+
+#include <rvv/rvv.hpp>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// FIR filters and the valid part of 1D convolutions and correlations, for
+// float, double and Q15 fixed point (int16_t) samples.
+//
+// A register holds the window of input samples of size() consecutive
+// outputs. After the multiply-accumulate with one tap, the window moves by
+// one sample with vslide1down, which takes the single new sample as a
+// scalar, so every input sample is loaded once per register instead of once
+// per tap. Several registers of outputs are computed together to overlap
+// the accumulation chains.
+//
+// Q15 samples are widened to 32-bit lanes, the products accumulate in Q30
+// and are narrowed back with rounding and saturation (vnclip). The
+// accumulator does not overflow as long as the absolute values of the taps
+// add up to less than 2.
+//
+// IIR filters do not vectorize along time, biquad_bank runs many
+// independent channels instead, one channel per lane. Coefficients and
+// state are kept channel minor (structure of arrays), so a register of
+// channels loads with one contiguous load, and the input is a sequence of
+// frames holding one sample per channel.
+
+namespace rvv::dsp {
+
+    namespace dsp_impl {
+
+        // registers of outputs per pass of the main loop
+        inline constexpr std::size_t unroll = 4;
+
+        // frames per pass of a biquad section
+        inline constexpr std::size_t frame_block = 64;
+
+        template <typename T>
+        struct sample_ops;
+
+        template <>
+        struct sample_ops<float>
+        {
+            static constexpr size_t lanes = RVV_LEN / 32;
+            using acc_t = float;
+            typedef vfloat32m1_t vector
+                __attribute__((riscv_rvv_vector_bits(RVV_LEN)));
+
+            static vector load(const float* p, size_t vl)
+            {
+                return __riscv_vle32_v_f32m1(p, vl);
+            }
+            static void store(float* p, vector v, size_t vl)
+            {
+                __riscv_vse32(p, v, vl);
+            }
+            static vector zero(size_t vl)
+            {
+                return __riscv_vfmv_v_f_f32m1(0.0f, vl);
+            }
+            // acc + h * x
+            static vector macc(vector acc, float h, vector x, size_t vl)
+            {
+                return __riscv_vfmacc(acc, h, x, vl);
+            }
+            // lanes moved down by one, s goes into lane vl - 1
+            static vector slide(vector x, float s, size_t vl)
+            {
+                return __riscv_vfslide1down(x, s, vl);
+            }
+        };
+
+        template <>
+        struct sample_ops<double>
+        {
+            static constexpr size_t lanes = RVV_LEN / 64;
+            using acc_t = double;
+            typedef vfloat64m1_t vector
+                __attribute__((riscv_rvv_vector_bits(RVV_LEN)));
+
+            static vector load(const double* p, size_t vl)
+            {
+                return __riscv_vle64_v_f64m1(p, vl);
+            }
+            static void store(double* p, vector v, size_t vl)
+            {
+                __riscv_vse64(p, v, vl);
+            }
+            static vector zero(size_t vl)
+            {
+                return __riscv_vfmv_v_f_f64m1(0.0, vl);
+            }
+            static vector macc(vector acc, double h, vector x, size_t vl)
+            {
+                return __riscv_vfmacc(acc, h, x, vl);
+            }
+            static vector slide(vector x, double s, size_t vl)
+            {
+                return __riscv_vfslide1down(x, s, vl);
+            }
+        };
+
+        template <>
+        struct sample_ops<int16_t>
+        {
+            static constexpr size_t lanes = RVV_LEN / 32;
+            using acc_t = int32_t;
+            typedef vint32m1_t vector
+                __attribute__((riscv_rvv_vector_bits(RVV_LEN)));
+
+            static vector load(const int16_t* p, size_t vl)
+            {
+                return __riscv_vsext_vf2_i32m1(__riscv_vle16_v_i16mf2(p, vl), vl);
+            }
+            static void store(int16_t* p, vector v, size_t vl)
+            {
+                __riscv_vse16(
+                    p, __riscv_vnclip_wx_i16mf2(v, 15, __RISCV_VXRM_RNU, vl), vl);
+            }
+            static vector zero(size_t vl)
+            {
+                return __riscv_vmv_v_x_i32m1(0, vl);
+            }
+            static vector macc(vector acc, int32_t h, vector x, size_t vl)
+            {
+                return __riscv_vmacc(acc, h, x, vl);
+            }
+            static vector slide(vector x, int32_t s, size_t vl)
+            {
+                return __riscv_vslide1down(x, s, vl);
+            }
+        };
+
+        template <typename T>
+        inline constexpr bool is_sample = std::is_same_v<T, float> ||
+            std::is_same_v<T, double> || std::is_same_v<T, int16_t>;
+
+        // y[i] = sum_j h[j] * x[i + j] for the size - k + 1 outputs, with h
+        // read backwards when Reverse is set
+        template <bool Reverse, typename T>
+        inline std::size_t filter(
+            const T* x, std::size_t size, const T* h, std::size_t k, T* y)
+        {
+            using ops = sample_ops<T>;
+            using A = typename ops::acc_t;
+            constexpr std::size_t N = ops::lanes;
+            if (k == 0 || size < k)
+                return 0;
+            const std::size_t outputs = size - k + 1;
+
+            // R registers of vl outputs each from output i on, the last
+            // sample a window takes in is x[i + r * N + vl + k - 2], which is
+            // in range
+            auto block = [&]<std::size_t R>(std::size_t i,
+                             std::integral_constant<std::size_t, R>,
+                             std::size_t vl) {
+                std::array<typename ops::vector, R> window, acc;
+                for (std::size_t r = 0; r < R; r++)
+                {
+                    window[r] = ops::load(x + i + r * N, vl);
+                    acc[r] = ops::zero(vl);
+                }
+                for (std::size_t j = 0; j < k; j++)
+                {
+                    const A tap = A(h[Reverse ? k - 1 - j : j]);
+                    for (std::size_t r = 0; r < R; r++)
+                        acc[r] = ops::macc(acc[r], tap, window[r], vl);
+                    if (j + 1 == k)
+                        break;
+                    for (std::size_t r = 0; r < R; r++)
+                        window[r] = ops::slide(
+                            window[r], A(x[i + r * N + vl + j]), vl);
+                }
+                for (std::size_t r = 0; r < R; r++)
+                    ops::store(y + i + r * N, acc[r], vl);
+            };
+
+            std::size_t i = 0;
+            for (; i + unroll * N <= outputs; i += unroll * N)
+                block(i, std::integral_constant<std::size_t, unroll>{}, N);
+            for (; i + N <= outputs; i += N)
+                block(i, std::integral_constant<std::size_t, 1>{}, N);
+            if (i < outputs)
+                block(i, std::integral_constant<std::size_t, 1>{}, outputs - i);
+            return outputs;
+        }
+
+        template <bool Reverse, typename Signal, typename Taps, typename Out>
+        inline std::size_t filter(Signal&& signal, Taps&& taps, Out&& out)
+        {
+            using T = std::remove_cv_t<std::ranges::range_value_t<Signal>>;
+            static_assert(is_sample<T> &&
+                    std::is_same_v<T,
+                        std::remove_cv_t<std::ranges::range_value_t<Taps>>> &&
+                    std::is_same_v<T, std::ranges::range_value_t<Out>>,
+                "dsp filters only work for float, double and Q15 int16_t "
+                "samples of one type");
+            return filter<Reverse>(std::ranges::data(signal),
+                std::ranges::size(signal), std::ranges::data(taps),
+                std::ranges::size(taps), std::ranges::data(out));
+        }
+    }    // namespace dsp_impl
+
+    // Causal FIR filter, out[i] = sum_j taps[j] * signal[i + taps.size() - 1
+    // - j] is the response at sample i + taps.size() - 1. Writes and returns
+    // the signal.size() - taps.size() + 1 outputs that have a full history,
+    // a stream keeps the last taps.size() - 1 samples in front of its next
+    // block.
+    template <std::ranges::contiguous_range Signal,
+        std::ranges::contiguous_range Taps, std::ranges::contiguous_range Out>
+    inline std::size_t fir(Signal&& signal, Taps&& taps, Out&& out)
+    {
+        return dsp_impl::filter<true>(signal, taps, out);
+    }
+
+    // Valid part of the convolution of signal and kernel, the same outputs
+    // as fir
+    template <std::ranges::contiguous_range Signal,
+        std::ranges::contiguous_range Kernel, std::ranges::contiguous_range Out>
+    inline std::size_t convolve(Signal&& signal, Kernel&& kernel, Out&& out)
+    {
+        return dsp_impl::filter<true>(signal, kernel, out);
+    }
+
+    // Valid part of the correlation, out[i] = sum_j kernel[j] *
+    // signal[i + j]
+    template <std::ranges::contiguous_range Signal,
+        std::ranges::contiguous_range Kernel, std::ranges::contiguous_range Out>
+    inline std::size_t correlate(Signal&& signal, Kernel&& kernel, Out&& out)
+    {
+        return dsp_impl::filter<false>(signal, kernel, out);
+    }
+    // Biquad section in transposed direct form II, normalized to a0 = 1:
+    // y = b0 x + s1, s1 = b1 x - a1 y + s2, s2 = b2 x - a2 y
+    template <typename T>
+    struct biquad
+    {
+        T b0 = 1, b1 = 0, b2 = 0, a1 = 0, a2 = 0;
+    };
+
+    // A cascade of sections per channel, every section starts as a pass
+    // through with zero state
+    template <typename T>
+    struct biquad_bank
+    {
+        static_assert(std::is_floating_point_v<T>,
+            "biquad_bank only works for floating point types");
+
+        // per section, the values of all channels for each coefficient and
+        // state variable
+        static constexpr std::size_t coefficient_count = 5;
+        static constexpr std::size_t state_count = 2;
+
+        std::size_t channels = 0;
+        std::size_t sections = 0;
+        // b0, b1, b2, -a1, -a2 of section s for channel c at
+        // coefficients[(s * coefficient_count + k) * channels + c]
+        std::vector<T> coefficients;
+        // s1, s2 at state[(s * state_count + k) * channels + c]
+        std::vector<T> state;
+
+        biquad_bank(std::size_t channels, std::size_t sections = 1)
+          : channels(channels)
+          , sections(sections)
+          , coefficients(sections * coefficient_count * channels, T(0))
+          , state(sections * state_count * channels, T(0))
+        {
+            for (std::size_t s = 0; s < sections; s++)
+                std::fill_n(coefficients.begin() + s * coefficient_count * channels,
+                    channels, T(1));
+        }
+
+        void set(std::size_t channel, std::size_t section, const biquad<T>& c)
+        {
+            T* p = coefficients.data() +
+                section * coefficient_count * channels + channel;
+            p[0] = c.b0;
+            p[channels] = c.b1;
+            p[2 * channels] = c.b2;
+            p[3 * channels] = -c.a1;
+            p[4 * channels] = -c.a2;
+        }
+
+        // clears the state of all channels
+        void reset()
+        {
+            std::fill(state.begin(), state.end(), T(0));
+        }
+    };
+
+    // Runs frames frames through the cascades, sample c of frame f is
+    // at in[f * channels + c]. in and out may be the same buffer. The state
+    // carries over to the next call.
+    //
+    // A register of channels runs through a block of frames one section at
+    // a time, with the coefficients and state of the section in registers,
+    // the samples between the sections stay in out while the block is in L1.
+    template <typename T>
+    inline void process(
+        biquad_bank<T>& bank, const T* in, T* out, std::size_t frames)
+    {
+        using namespace rvv::experimental;
+        constexpr std::size_t N = simd<T>::size();
+        constexpr std::size_t C = biquad_bank<T>::coefficient_count;
+        constexpr std::size_t S = biquad_bank<T>::state_count;
+        const std::size_t channels = bank.channels;
+        auto load = [](const T* p, std::size_t vl) {
+            simd<T> x;
+            x.partial_copy_from(p, vl);
+            return x;
+        };
+
+        if (bank.sections == 0)
+        {
+            if (in != out)
+                std::copy(in, in + frames * channels, out);
+            return;
+        }
+        for (std::size_t c = 0; c < channels; c += N)
+        {
+            const std::size_t vl = std::min(N, channels - c);
+            for (std::size_t f0 = 0; f0 < frames; f0 += dsp_impl::frame_block)
+            {
+                const std::size_t f1 = std::min(frames, f0 + dsp_impl::frame_block);
+                for (std::size_t s = 0; s < bank.sections; s++)
+                {
+                    const T* h = bank.coefficients.data() + s * C * channels + c;
+                    T* state = bank.state.data() + s * S * channels + c;
+                    const simd<T> b0 = load(h, vl), b1 = load(h + channels, vl),
+                                  b2 = load(h + 2 * channels, vl),
+                                  a1 = load(h + 3 * channels, vl),
+                                  a2 = load(h + 4 * channels, vl);
+                    simd<T> s1 = load(state, vl), s2 = load(state + channels, vl);
+                    const T* src = s == 0 ? in : out;
+                    for (std::size_t f = f0; f < f1; f++)
+                    {
+                        const simd<T> x = load(src + f * channels + c, vl);
+                        const simd<T> y = fma(b0, x, s1);
+                        s1 = fma(b1, x, fma(a1, y, s2));
+                        s2 = fma(b2, x, a2 * y);
+                        y.partial_copy_to(out + f * channels + c, vl);
+                    }
+                    s1.partial_copy_to(state, vl);
+                    s2.partial_copy_to(state + channels, vl);
+                }
+            }
+        }
+    }
+}    // namespace rvv::dsp
@@ -0,0 +1,495 @@
+#pragma once
+
+#include <rvv/rvv.hpp>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+// Power of two complex FFTs on split real and imaginary arrays.
+//
+// A plan holds everything that depends on the length only: the bit
+// reversal permutation and the twiddle factors w^k, w^2k and w^3k of every
+// radix-4 stage, computed once in double precision so that execute() does
+// no trigonometry and no allocation, and can be called any number of times.
+//
+// execute() copies the input to the output in bit reversed order with
+// gathers and runs decimation in time stages in place on the output:
+//  - with index (h, m, l) split into tile_bits high bits h, tile_bits low
+//    bits l and the middle bits m, output (h, m, l) is input (rev l, rev m,
+//    rev h). For every m this transposes a tile of B x B elements. The B
+//    input rows lie a power of two apart and would map to the same few L1
+//    sets, so they are first copied into a contiguous B x B staging block
+//    on the stack, and a row of B outputs gathers from that block with a
+//    precomputed index vector. The scalar swap loop misses the cache on
+//    almost every element of a large transform. Short transforms gather
+//    directly with the full reversed index table.
+//  - the first 2, 4 or 8 point stage runs in registers, register r holds
+//    element r of size() independent blocks, read with a strided load, so
+//    a whole radix-8 block fits in 16 registers and needs no shuffles
+//  - every further stage is radix-4, one pass over the data per two levels
+//    of the radix-2 recursion. With quarters of at least size() elements a
+//    register holds consecutive k and the twiddles load from the tables,
+//    shorter quarters take one block per lane with strided loads and
+//    broadcast twiddles.
+//
+// The inverse transform conjugates the twiddles and scales by 1 / n in the
+// first stage. execute() only reads the plan, so threads can share one.
+
+namespace rvv::fft {
+
+    enum class direction
+    {
+        forward,
+        inverse
+    };
+
+    namespace fft_impl {
+
+        using namespace rvv::experimental;
+
+        template <typename T>
+        struct cvec
+        {
+            simd<T> re, im;
+        };
+
+        template <typename T>
+        inline cvec<T> operator+(const cvec<T>& x, const cvec<T>& y)
+        {
+            return {x.re + y.re, x.im + y.im};
+        }
+
+        template <typename T>
+        inline cvec<T> operator-(const cvec<T>& x, const cvec<T>& y)
+        {
+            return {x.re - y.re, x.im - y.im};
+        }
+
+        // x * (c + i s) forward, x * (c - i s) inverse
+        template <bool Inverse, typename T>
+        inline cvec<T> twiddle(const cvec<T>& x, const simd<T>& c, const simd<T>& s)
+        {
+            if constexpr (Inverse)
+                return {x.re * c + x.im * s, x.im * c - x.re * s};
+            else
+                return {x.re * c - x.im * s, x.re * s + x.im * c};
+        }
+
+        // x * w4: x * -i forward, x * i inverse
+        template <bool Inverse, typename T>
+        inline cvec<T> quarter(const cvec<T>& x)
+        {
+            if constexpr (Inverse)
+                return {-x.im, x.re};
+            else
+                return {x.im, -x.re};
+        }
+
+        // x * w8: x * (1 - i) / sqrt(2) forward, x * (1 + i) / sqrt(2)
+        // inverse
+        template <bool Inverse, typename T>
+        inline cvec<T> eighth(const cvec<T>& x)
+        {
+            const simd<T> h(T(0.70710678118654752440L));
+            if constexpr (Inverse)
+                return {(x.re - x.im) * h, (x.re + x.im) * h};
+            else
+                return {(x.re + x.im) * h, (x.im - x.re) * h};
+        }
+
+        // 4 point DFT of t0 .. t3, the subsequences 4j, 4j + 1, 4j + 2 and
+        // 4j + 3 already multiplied by their twiddles, into t0 .. t3
+        template <bool Inverse, typename T>
+        inline void radix4(cvec<T>& t0, cvec<T>& t1, cvec<T>& t2, cvec<T>& t3)
+        {
+            const cvec<T> s02 = t0 + t2, d02 = t0 - t2;
+            const cvec<T> s13 = t1 + t3, d13 = quarter<Inverse>(t1 - t3);
+            t0 = s02 + s13;
+            t1 = d02 + d13;
+            t2 = s02 - s13;
+            t3 = d02 - d13;
+        }
+
+        inline std::size_t reverse_bits(std::size_t i, std::size_t bits)
+        {
+            std::size_t r = 0;
+            for (std::size_t b = 0; b < bits; b++)
+                r |= ((i >> b) & 1) << (bits - 1 - b);
+            return r;
+        }
+
+        // G point DFT of bit reversed input held one element per register
+        template <std::size_t G, bool Inverse, typename T>
+        inline void codelet(std::array<cvec<T>, G>& x)
+        {
+            if constexpr (G == 2)
+            {
+                const cvec<T> u = x[0];
+                x[0] = u + x[1];
+                x[1] = u - x[1];
+            }
+            else if constexpr (G == 4)
+            {
+                // positions 0 .. 3 hold the DFTs of the subsequences 0, 2,
+                // 1 and 3
+                std::swap(x[1], x[2]);
+                radix4<Inverse>(x[0], x[1], x[2], x[3]);
+            }
+            else
+            {
+                static_assert(G == 8, "codelet only works for 2, 4 or 8 points");
+                for (std::size_t r = 0; r < 8; r += 2)
+                {
+                    const cvec<T> u = x[r];
+                    x[r] = u + x[r + 1];
+                    x[r + 1] = u - x[r + 1];
+                }
+                // quarters of two: k = 0 needs no twiddles, k = 1 takes w8,
+                // w8^2 and w8^3
+                cvec<T> t1 = x[4], t2 = x[2];
+                radix4<Inverse>(x[0], t1, t2, x[6]);
+                x[4] = t2;
+                x[2] = t1;
+                t1 = eighth<Inverse>(x[5]);
+                t2 = quarter<Inverse>(x[3]);
+                cvec<T> t3 = quarter<Inverse>(eighth<Inverse>(x[7]));
+                radix4<Inverse>(x[1], t1, t2, t3);
+                x[3] = t1;
+                x[5] = t2;
+                x[7] = t3;
+            }
+        }
+
+        // the first stage, G point DFTs of n / G blocks with one block per
+        // lane, scaled by scale
+        template <std::size_t G, bool Inverse, typename T>
+        inline void first_stage(T* re, T* im, std::size_t n, T scale)
+        {
+            constexpr std::size_t N = simd<T>::size();
+            const std::size_t blocks = n / G;
+            for (std::size_t b = 0; b < blocks; b += N)
+            {
+                const std::size_t vl = std::min(N, blocks - b);
+                T* pr = re + b * G;
+                T* pi = im + b * G;
+                std::array<cvec<T>, G> x;
+                for (std::size_t r = 0; r < G; r++)
+                {
+                    x[r].re.strided_copy_from(pr + r, G, vl);
+                    x[r].im.strided_copy_from(pi + r, G, vl);
+                    if constexpr (Inverse)
+                    {
+                        x[r].re *= simd<T>(scale);
+                        x[r].im *= simd<T>(scale);
+                    }
+                }
+                codelet<G, Inverse>(x);
+                for (std::size_t r = 0; r < G; r++)
+                {
+                    x[r].re.strided_copy_to(pr + r, G, vl);
+                    x[r].im.strided_copy_to(pi + r, G, vl);
+                }
+            }
+        }
+
+        // allocates on a register boundary, so that tables whose offsets
+        // are whole registers start on one
+        template <typename T>
+        struct register_allocator
+        {
+            using value_type = T;
+            static constexpr std::align_val_t alignment{
+                simd<T>::size() * sizeof(T)};
+
+            register_allocator() = default;
+            template <typename U>
+            register_allocator(const register_allocator<U>&)
+            {
+            }
+
+            T* allocate(std::size_t n)
+            {
+                return static_cast<T*>(::operator new(n * sizeof(T), alignment));
+            }
+            void deallocate(T* p, std::size_t)
+            {
+                ::operator delete(p, alignment);
+            }
+
+            template <typename U>
+            bool operator==(const register_allocator<U>&) const
+            {
+                return true;
+            }
+        };
+
+        // twiddles of one radix-4 stage over quarters of L elements: the
+        // real and imaginary parts of w^k, w^2k and w^3k for k < L, each
+        // table padded to whole registers
+        template <typename T>
+        inline std::size_t table_stride(std::size_t L)
+        {
+            constexpr std::size_t N = simd<T>::size();
+            return (L + N - 1) / N * N;
+        }
+
+        template <bool Inverse, typename T>
+        inline void radix4_stage(
+            T* re, T* im, std::size_t n, std::size_t L, const T* w)
+        {
+            constexpr std::size_t N = simd<T>::size();
+            const std::size_t stride = table_stride<T>(L);
+            const T* w1 = w;
+            const T* w2 = w + 2 * stride;
+            const T* w3 = w + 4 * stride;
+
+            auto butterfly = [](cvec<T>* x, const simd<T>* c) {
+                cvec<T> t0 = x[0];
+                cvec<T> t1 = twiddle<Inverse>(x[2], c[0], c[1]);
+                cvec<T> t2 = twiddle<Inverse>(x[1], c[2], c[3]);
+                cvec<T> t3 = twiddle<Inverse>(x[3], c[4], c[5]);
+                radix4<Inverse>(t0, t1, t2, t3);
+                x[0] = t0;
+                x[1] = t1;
+                x[2] = t2;
+                x[3] = t3;
+            };
+
+            if (L >= N)
+            {
+                for (std::size_t b = 0; b < n; b += 4 * L)
+                {
+                    for (std::size_t k = 0; k < L; k += N)
+                    {
+                        const simd<T> c[6] = {simd<T>(w1 + k, vector_aligned),
+                            simd<T>(w1 + stride + k, vector_aligned),
+                            simd<T>(w2 + k, vector_aligned),
+                            simd<T>(w2 + stride + k, vector_aligned),
+                            simd<T>(w3 + k, vector_aligned),
+                            simd<T>(w3 + stride + k, vector_aligned)};
+                        cvec<T> x[4];
+                        for (std::size_t p = 0; p < 4; p++)
+                            x[p] = {simd<T>(re + b + p * L + k, element_aligned),
+                                simd<T>(im + b + p * L + k, element_aligned)};
+                        butterfly(x, c);
+                        for (std::size_t p = 0; p < 4; p++)
+                        {
+                            x[p].re.copy_to(re + b + p * L + k, element_aligned);
+                            x[p].im.copy_to(im + b + p * L + k, element_aligned);
+                        }
+                    }
+                }
+                return;
+            }
+
+            const std::size_t blocks = n / (4 * L);
+            for (std::size_t k = 0; k < L; k++)
+            {
+                const simd<T> c[6] = {simd<T>(w1[k]), simd<T>(w1[stride + k]),
+                    simd<T>(w2[k]), simd<T>(w2[stride + k]), simd<T>(w3[k]),
+                    simd<T>(w3[stride + k])};
+                for (std::size_t b = 0; b < blocks; b += N)
+                {
+                    const std::size_t vl = std::min(N, blocks - b);
+                    const std::size_t base = b * 4 * L + k;
+                    cvec<T> x[4];
+                    for (std::size_t p = 0; p < 4; p++)
+                    {
+                        x[p].re.strided_copy_from(re + base + p * L, 4 * L, vl);
+                        x[p].im.strided_copy_from(im + base + p * L, 4 * L, vl);
+                    }
+                    butterfly(x, c);
+                    for (std::size_t p = 0; p < 4; p++)
+                    {
+                        x[p].re.strided_copy_to(re + base + p * L, 4 * L, vl);
+                        x[p].im.strided_copy_to(im + base + p * L, 4 * L, vl);
+                    }
+                }
+            }
+        }
+    }    // namespace fft_impl
+
+    // Precomputed FFT of a power of two length n, the byte offsets of the
+    // permutation gathers limit float transforms to 2^30 points
+    template <typename T>
+    struct plan
+    {
+        static_assert(std::is_floating_point_v<T>,
+            "plan only works for floating point types");
+
+        using index_type = rvv_impl::index_of<T>;
+
+        std::size_t n = 0;
+        // points of the first stage, 1, 2, 4 or 8, the rest is radix-4
+        std::size_t first = 1;
+        // bits of a side of the permutation tiles, 0 for a direct gather
+        std::size_t tile_bits = 0;
+        // direct: input element of output position i, padded to whole
+        // registers; tiled: rev l << tile_bits for the low bits l, the
+        // staging block offset of row rev l
+        std::vector<index_type> reversed;
+        // tiled: rev m << tile_bits for the middle bits m
+        std::vector<std::size_t> middle;
+        // tables of the radix-4 stages one after the other, forward
+        // direction, every table starting on a register boundary
+        std::vector<T, fft_impl::register_allocator<T>> twiddles;
+
+        explicit plan(std::size_t n)
+          : n(n)
+        {
+            if (!std::has_single_bit(n))
+                throw std::invalid_argument("fft length must be a power of two");
+            const std::size_t bits = std::countr_zero(n);
+            // an odd number of levels starts with radix-8, an even with
+            // radix-4, so that the rest pairs up into radix-4 stages
+            if (bits > 0)
+                first = bits == 1 ? 2 : (bits % 2 ? 8 : 4);
+
+            constexpr std::size_t N = rvv::experimental::simd<T>::size();
+            if (bits >= 2 * std::countr_zero(tile_side))
+            {
+                tile_bits = std::countr_zero(tile_side);
+                const std::size_t middle_bits = bits - 2 * tile_bits;
+                for (std::size_t l = 0; l < (std::size_t(1) << tile_bits); l++)
+                    reversed.push_back(index_type(
+                        fft_impl::reverse_bits(l, tile_bits) << tile_bits));
+                for (std::size_t m = 0; m < (std::size_t(1) << middle_bits); m++)
+                    middle.push_back(fft_impl::reverse_bits(m, middle_bits) << tile_bits);
+            }
+            else
+            {
+                reversed.resize((n + N - 1) / N * N, index_type(0));
+                for (std::size_t i = 0; i < n; i++)
+                    reversed[i] = index_type(fft_impl::reverse_bits(i, bits));
+            }
+
+            const double pi = std::acos(-1.0);
+            for (std::size_t L = first; 4 * L <= n; L *= 4)
+            {
+                const std::size_t stride = fft_impl::table_stride<T>(L);
+                const std::size_t offset = twiddles.size();
+                twiddles.resize(offset + 6 * stride, T(0));
+                for (std::size_t m = 1; m <= 3; m++)
+                {
+                    T* w = twiddles.data() + offset + (m - 1) * 2 * stride;
+                    for (std::size_t k = 0; k < L; k++)
+                    {
+                        const double angle = -2 * pi * double(m * k) / double(4 * L);
+                        w[k] = T(std::cos(angle));
+                        w[stride + k] = T(std::sin(angle));
+                    }
+                }
+            }
+        }
+
+        std::size_t size() const
+        {
+            return n;
+        }
+
+        // Transforms n complex values, the real parts at in_re and the
+        // imaginary parts at in_im, to out_re and out_im. The output must
+        // not overlap the input. The inverse is scaled by 1 / n.
+        void execute(const T* in_re, const T* in_im, T* out_re, T* out_im,
+            direction dir = direction::forward) const
+        {
+            permute(in_re, in_im, out_re, out_im);
+            if (dir == direction::inverse)
+                run<true>(out_re, out_im);
+            else
+                run<false>(out_re, out_im);
+        }
+
+    private:
+        // side of the permutation tiles, at least a register and a cache
+        // line per row
+        static constexpr std::size_t tile_side = std::max<std::size_t>(
+            16, rvv::experimental::simd<T>::size());
+
+        // out[i] = in[rev i]
+        void permute(
+            const T* in_re, const T* in_im, T* out_re, T* out_im) const
+        {
+            using namespace rvv::experimental;
+            constexpr std::size_t N = simd<T>::size();
+            if (tile_bits == 0)
+            {
+                for (std::size_t i = 0; i < n; i += N)
+                {
+                    const simd<index_type> idx(reversed.data() + i, element_aligned);
+                    const std::size_t vl = std::min(N, n - i);
+                    gather(in_re, idx).partial_copy_to(out_re + i, vl);
+                    gather(in_im, idx).partial_copy_to(out_im + i, vl);
+                }
+                return;
+            }
+
+            // B x B real then imaginary input rows of the current tile
+            constexpr std::size_t B = tile_side;
+            alignas(N * sizeof(T)) T staging[2 * B * B];
+            const std::size_t shift = std::countr_zero(n) - tile_bits;
+            T* stage_re = staging;
+            T* stage_im = staging + B * B;
+            for (std::size_t m = 0; m < middle.size(); m++)
+            {
+                // input row r of the tile to row r of the staging block
+                for (std::size_t r = 0; r < B; r++)
+                {
+                    const std::size_t from = (r << shift) | middle[m];
+                    for (std::size_t c = 0; c < B; c += N)
+                    {
+                        simd<T>(in_re + from + c, element_aligned)
+                            .copy_to(stage_re + r * B + c, element_aligned);
+                        simd<T>(in_im + from + c, element_aligned)
+                            .copy_to(stage_im + r * B + c, element_aligned);
+                    }
+                }
+                for (std::size_t h = 0; h < B; h++)
+                {
+                    // column rev h of the staging block
+                    const std::size_t from = reversed[h] >> tile_bits;
+                    const std::size_t to = (h << shift) | (m << tile_bits);
+                    for (std::size_t l = 0; l < B; l += N)
+                    {
+                        const simd<index_type> idx(reversed.data() + l, element_aligned);
+                        gather(stage_re + from, idx).copy_to(out_re + to + l, element_aligned);
+                        gather(stage_im + from, idx).copy_to(out_im + to + l, element_aligned);
+                    }
+                }
+            }
+        }
+
+        template <bool Inverse>
+        void run(T* re, T* im) const
+        {
+            using namespace fft_impl;
+            const T scale = T(1) / T(n);
+            switch (first)
+            {
+            case 2:
+                first_stage<2, Inverse>(re, im, n, scale);
+                break;
+            case 4:
+                first_stage<4, Inverse>(re, im, n, scale);
+                break;
+            case 8:
+                first_stage<8, Inverse>(re, im, n, scale);
+                break;
+            default:
+                break;
+            }
+            const T* w = twiddles.data();
+            for (std::size_t L = first; 4 * L <= n; L *= 4)
+            {
+                radix4_stage<Inverse>(re, im, n, L, w);
+                w += 6 * table_stride<T>(L);
+            }
+        }
+    };
+}    // namespace rvv::fft
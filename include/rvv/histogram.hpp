@@ -0,0 +1,129 @@
+#pragma once
+
+#include <rvv/rvv.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <type_traits>
+#include <vector>
+
+// Histograms of 32-bit integer values.
+//
+// Up to private_bins bins, every lane counts into its own copy of the
+// histogram, so the gather, increment and scatter of a register never
+// touches the same counter twice. Values out of range go to one more counter
+// per copy that is dropped. The copies are added up with vector adds at the
+// end.
+//
+// Larger histograms are updated in place. Lanes of a register that share a
+// bin are found by scattering the lane numbers into a tag array indexed by
+// bin and gathering them back: exactly one lane of every bin reads its own
+// number. Those lanes update their counters, the others are compressed to
+// the front and go again, so a register takes as many rounds as its most
+// frequent value.
+//
+// Counters are gathered and scattered through 32-bit element indices that
+// the simd layer turns into byte offsets, so histograms have less than 2^30
+// bins.
+
+namespace rvv {
+
+    namespace histogram_impl {
+
+        using namespace rvv::experimental;
+        using vector = simd<uint32_t>;
+
+        inline constexpr size_t lanes = vector::size();
+        inline constexpr size_t private_bins = 256;
+
+        inline vector load(const uint32_t* p, size_t vl)
+        {
+            vector x;
+            x.partial_copy_from(p, vl);
+            return x;
+        }
+
+        inline void count_private(
+            const uint32_t* data, size_t n, uint32_t* bins, size_t m)
+        {
+            // lane l counts into table[l * row, (l + 1) * row)
+            const size_t row = m + 1;
+            std::vector<uint32_t> table(lanes * row);
+            const vector base = vector(vector::index0123) * uint32_t(row);
+            for (size_t i = 0; i < n;)
+            {
+                size_t vl = std::min(lanes, n - i);
+                vector x = min(load(data + i, vl), vector(uint32_t(m)));
+                vector index = x + base;
+                vector c = gather(table.data(), index, vl);
+                scatter(c + uint32_t(1), table.data(), index, vl);
+                i += vl;
+            }
+            for (size_t j = 0; j < m;)
+            {
+                size_t vl = std::min(lanes, m - j);
+                vector sum = load(bins + j, vl);
+                for (size_t l = 0; l < lanes; l++)
+                    sum += load(table.data() + l * row + j, vl);
+                sum.partial_copy_to(bins + j, vl);
+                j += vl;
+            }
+        }
+
+        inline void count_shared(
+            const uint32_t* data, size_t n, uint32_t* bins, size_t m)
+        {
+            std::vector<uint32_t> tags(m);
+            const vector lane(vector::index0123);
+            for (size_t i = 0; i < n;)
+            {
+                size_t vl = std::min(lanes, n - i);
+                vector x = load(data + i, vl);
+                auto in_range = x < vector(uint32_t(m)) &&
+                    lane < vector(uint32_t(vl));
+                size_t k = popcount(in_range);
+                vector index = compact(in_range, x);
+                while (k > 0)
+                {
+                    // one lane of each bin wins the tag
+                    scatter(lane, tags.data(), index, k);
+                    auto won = gather(tags.data(), index, k) == lane &&
+                        lane < vector(uint32_t(k));
+                    size_t w = popcount(won);
+                    vector target = w == k ? index : compact(won, index);
+                    vector c = gather(bins, target, w);
+                    scatter(c + uint32_t(1), bins, target, w);
+                    if (w == k)
+                        break;
+                    index = compact(!won, index);
+                    k -= w;
+                }
+                i += vl;
+            }
+        }
+    }    // namespace histogram_impl
+
+    // Adds the number of occurrences of every value b < bins.size() of data
+    // to bins[b], other values are ignored. Negative values of signed data
+    // are out of range.
+    template <std::ranges::contiguous_range Data,
+        std::ranges::contiguous_range Bins>
+    inline void histogram(Data&& data, Bins&& bins)
+    {
+        using T = std::remove_cv_t<std::ranges::range_value_t<Data>>;
+        static_assert(std::is_integral_v<T> && sizeof(T) == 4 &&
+                std::is_same_v<std::ranges::range_value_t<Bins>, uint32_t>,
+            "histogram only works for 32-bit integral values and uint32_t "
+            "counts");
+        const auto* p = reinterpret_cast<const uint32_t*>(std::ranges::data(data));
+        const size_t n = std::ranges::size(data);
+        const size_t m = std::ranges::size(bins);
+        if (m == 0)
+            return;
+        if (m <= histogram_impl::private_bins)
+            histogram_impl::count_private(p, n, std::ranges::data(bins), m);
+        else
+            histogram_impl::count_shared(p, n, std::ranges::data(bins), m);
+    }
+}    // namespace rvv
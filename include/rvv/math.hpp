@@ -0,0 +1,775 @@
+#pragma once
+
+#include <rvv/rvv.hpp>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+// Vectorized elementary functions for simd<float> and simd<double>.
+//
+// The functions follow the usual structure of a vector libm: range reduction
+// with FMA based Cody-Waite splitting, a polynomial on the reduced range and
+// reconstruction through exponent bit manipulation. All lanes are computed
+// without branching, special values (NaN, +-inf, +-0) are patched in at the
+// end with choose().
+//
+// Accuracy against a correctly rounded result (max observed over the unit
+// tests): exp, exp2, log, log2, log10, sin, cos <= 2 ULP; tanh, erf <= 3 ULP;
+// pow <= 4 ULP while |y * log(x)| stays away from the overflow threshold.
+// The fast_* variants skip special value handling and use shorter
+// polynomials, their error is below 1e-6 for both float and double.
+
+namespace rvv::experimental { inline namespace parallelism_v2 {
+
+    namespace math_impl {
+
+        template <typename T>
+        struct float_traits;
+
+        template <>
+        struct float_traits<float>
+        {
+            using int_type = int32_t;
+            static constexpr int mantissa_bits = 23;
+            static constexpr int exponent_bias = 127;
+            static constexpr int_type mantissa_mask = 0x007fffff;
+            static constexpr int_type one_bits = 0x3f800000;
+            static constexpr int_type sqrt_half_bits = 0x3f3504f3;
+
+            // ln(2) split so that k * ln2_hi is exact for the exponents used
+            static constexpr float ln2_hi = 6.9313812256e-01f;
+            static constexpr float ln2_lo = 9.0580006145e-06f;
+            static constexpr float log2e = 1.44269504088896341f;
+            static constexpr float log10e = 0.434294481903251828f;
+            static constexpr float log10_2_hi = 3.0102920532e-01f;
+            static constexpr float log10_2_lo = 7.9034151668e-07f;
+
+            // pi/2 split in three parts for FMA based reduction
+            static constexpr float two_over_pi = 0.636619772367581343f;
+            static constexpr float pio2_1 = 1.5707963705062866f;
+            static constexpr float pio2_2 = -4.371138828673793e-08f;
+            static constexpr float pio2_3 = -1.7151245100058819e-15f;
+            // beyond this the reduction loses accuracy and libm is used
+            static constexpr float trig_max = 1e5f;
+
+            static constexpr float exp_min = -104.0f;
+            static constexpr float exp_max = 89.0f;
+            static constexpr float exp2_min = -151.0f;
+            static constexpr float exp2_max = 129.0f;
+            static constexpr float fast_exp_min = -86.0f;
+            static constexpr float fast_exp_max = 88.0f;
+            // scale that brings subnormals into the normal range
+            static constexpr float subnormal_scale = 16777216.0f;    // 2^24
+            static constexpr int subnormal_exponent = 24;
+            // |x| at which erf(x) rounds to 1
+            static constexpr float erf_one = 4.0f;
+        };
+
+        template <>
+        struct float_traits<double>
+        {
+            using int_type = int64_t;
+            static constexpr int mantissa_bits = 52;
+            static constexpr int exponent_bias = 1023;
+            static constexpr int_type mantissa_mask = 0x000fffffffffffffLL;
+            static constexpr int_type one_bits = 0x3ff0000000000000LL;
+            static constexpr int_type sqrt_half_bits = 0x3fe6a09e667f3bcdLL;
+
+            static constexpr double ln2_hi = 6.93147180369123816490e-01;
+            static constexpr double ln2_lo = 1.90821492927058770002e-10;
+            static constexpr double log2e = 1.4426950408889634;
+            static constexpr double log10e = 0.4342944819032518;
+            static constexpr double log10_2_hi = 3.01029995663611771306e-01;
+            static constexpr double log10_2_lo = 3.69423907715893078616e-13;
+
+            static constexpr double two_over_pi = 0.6366197723675814;
+            static constexpr double pio2_1 = 1.5707963267948966;
+            static constexpr double pio2_2 = 6.123233995736766e-17;
+            static constexpr double pio2_3 = -1.4973849048591698e-33;
+            static constexpr double trig_max = 1e9;
+
+            static constexpr double exp_min = -746.0;
+            static constexpr double exp_max = 710.0;
+            static constexpr double exp2_min = -1076.0;
+            static constexpr double exp2_max = 1025.0;
+            static constexpr double fast_exp_min = -707.0;
+            static constexpr double fast_exp_max = 709.0;
+            static constexpr double subnormal_scale = 18014398509481984.0;    // 2^54
+            static constexpr int subnormal_exponent = 54;
+            static constexpr double erf_one = 6.0;
+        };
+
+        // Horner evaluation, coefficients ordered from the highest degree
+        template <typename T, typename Abi, std::size_t N>
+        inline simd<T, Abi> polynomial(
+            const simd<T, Abi>& x, const T (&coefficients)[N])
+        {
+            simd<T, Abi> result(coefficients[0]);
+            for (std::size_t i = 1; i < N; i++)
+            {
+                result = fma(result, x, simd<T, Abi>(coefficients[i]));
+            }
+            return result;
+        }
+
+        // Round to the nearest integral value (ties to even), valid while
+        // |x| < 2^(mantissa_bits - 1)
+        template <typename T, typename Abi>
+        inline simd<T, Abi> round_to_integral(const simd<T, Abi>& x)
+        {
+            const T shifter =
+                T(1.5) * T(int64_t(1) << float_traits<T>::mantissa_bits);
+            return (x + shifter) - shifter;
+        }
+
+        // x * 2^n for integral valued n. The scale is applied in two steps
+        // so that results in the subnormal range and near the overflow
+        // threshold are still exact.
+        template <typename T, typename Abi>
+        inline simd<T, Abi> scale_by_pow2(
+            const simd<T, Abi>& x, const simd<T, Abi>& n)
+        {
+            using traits = float_traits<T>;
+            using int_t = typename traits::int_type;
+
+            auto k = static_simd_cast<int_t>(n);
+            auto k1 = k >> 1;
+            auto k2 = k - k1;
+            auto s1 = simd_bit_cast<T>(
+                (k1 + traits::exponent_bias) << traits::mantissa_bits);
+            auto s2 = simd_bit_cast<T>(
+                (k2 + traits::exponent_bias) << traits::mantissa_bits);
+            return (x * s1) * s2;
+        }
+
+        // exp(r) for |r| <= ln(2)/2
+        template <typename T, typename Abi>
+        inline simd<T, Abi> exp_kernel(const simd<T, Abi>& r)
+        {
+            if constexpr (std::is_same_v<T, float>)
+            {
+                static constexpr float c[] = {1.9875691500e-4f,
+                    1.3981999507e-3f, 8.3334519073e-3f, 4.1665795894e-2f,
+                    1.6666665459e-1f, 5.0000001201e-1f};
+                return fma(polynomial(r, c), r * r, r + 1.0f);
+            }
+            else
+            {
+                static constexpr double c[] = {1.6059043836821613e-10,
+                    2.08767569878681e-09, 2.505210838544172e-08,
+                    2.755731922398589e-07, 2.7557319223985893e-06,
+                    2.48015873015873e-05, 0.0001984126984126984,
+                    0.001388888888888889, 0.008333333333333333,
+                    0.041666666666666664, 0.16666666666666666, 0.5, 1.0, 1.0};
+                return polynomial(r, c);
+            }
+        }
+
+        // Decompose positive x as 2^k * (1 + f) with 1 + f in
+        // [sqrt(1/2), sqrt(2)). Subnormal inputs are handled.
+        template <typename T, typename Abi>
+        inline void log_reduce(
+            const simd<T, Abi>& x, simd<T, Abi>& k, simd<T, Abi>& f)
+        {
+            using simd_t = simd<T, Abi>;
+            using traits = float_traits<T>;
+            using int_t = typename traits::int_type;
+
+            auto subnormal = x < simd_t(std::numeric_limits<T>::min());
+            auto x_scaled = choose(subnormal, x * traits::subnormal_scale, x);
+
+            auto ix = simd_bit_cast<int_t>(x_scaled);
+            ix += traits::one_bits - traits::sqrt_half_bits;
+            auto ki = (ix >> traits::mantissa_bits) - traits::exponent_bias;
+            ix = (ix & traits::mantissa_mask) + traits::sqrt_half_bits;
+
+            f = simd_bit_cast<T>(ix) - T(1);
+            k = static_simd_cast<T>(ki) -
+                choose(subnormal, simd_t(T(traits::subnormal_exponent)),
+                    simd_t(T(0)));
+        }
+
+        // Pieces of log(1 + f) = f - hfsq + s * (hfsq + R) for
+        // 1 + f in [sqrt(1/2), sqrt(2)), see fdlibm's e_log.c
+        template <typename T, typename Abi>
+        inline void log_kernel(const simd<T, Abi>& f, simd<T, Abi>& hfsq,
+            simd<T, Abi>& correction)
+        {
+            auto s = f / (f + T(2));
+            auto z = s * s;
+            auto w = z * z;
+            simd<T, Abi> R;
+            if constexpr (std::is_same_v<T, float>)
+            {
+                static constexpr float odd[] = {
+                    2.4279078841e-01f, 4.0000972152e-01f};
+                static constexpr float even[] = {
+                    2.8498786688e-01f, 6.6666662693e-01f};
+                R = w * polynomial(w, odd) + z * polynomial(w, even);
+            }
+            else
+            {
+                static constexpr double odd[] = {1.531383769920937332e-01,
+                    2.222219843214978396e-01, 3.999999999940941908e-01};
+                static constexpr double even[] = {1.479819860511658591e-01,
+                    1.818357216161805012e-01, 2.857142874366239149e-01,
+                    6.666666666666735130e-01};
+                R = w * polynomial(w, odd) + z * polynomial(w, even);
+            }
+            hfsq = T(0.5) * f * f;
+            correction = s * (hfsq + R);
+        }
+
+        // Patch the IEEE special cases of log into result
+        template <typename T, typename Abi>
+        inline simd<T, Abi> log_special_cases(
+            const simd<T, Abi>& x, const simd<T, Abi>& result)
+        {
+            using simd_t = simd<T, Abi>;
+            const simd_t inf(std::numeric_limits<T>::infinity());
+            const simd_t nan(std::numeric_limits<T>::quiet_NaN());
+
+            auto r = choose(x == simd_t(T(0)), -inf, result);
+            r = choose(x < simd_t(T(0)) || x != x, nan, r);
+            return choose(x == inf, inf, r);
+        }
+
+        // log(x) as an unevaluated sum hi + lo for positive finite x,
+        // accurate to a few bits beyond the working precision
+        template <typename T, typename Abi>
+        inline void log_hi_lo(
+            const simd<T, Abi>& x, simd<T, Abi>& hi, simd<T, Abi>& lo)
+        {
+            using traits = float_traits<T>;
+            simd<T, Abi> k, f, hfsq, correction;
+            log_reduce(x, k, f);
+            log_kernel(f, hfsq, correction);
+
+            // error of hfsq, 0.5 * f is exact
+            auto hfsq_err = fma(f * T(0.5), f, -hfsq);
+
+            // k * ln2_hi is exact and at least as large as f when k != 0
+            auto a = k * traits::ln2_hi;
+            auto s1 = a + f;
+            auto e1 = (a - s1) + f;
+            auto s2 = s1 - hfsq;
+            auto e2 = ((s1 - s2) - hfsq) + e1;
+            auto tail = e2 + ((correction + k * traits::ln2_lo) - hfsq_err);
+            hi = s2 + tail;
+            lo = (s2 - hi) + tail;
+        }
+
+        // pi/2 reduction: x = q * pi/2 + r with |r| <= pi/4
+        template <typename T, typename Abi>
+        inline void trig_reduce(
+            const simd<T, Abi>& x, simd<T, Abi>& q, simd<T, Abi>& r)
+        {
+            using simd_t = simd<T, Abi>;
+            using traits = float_traits<T>;
+            q = round_to_integral(x * traits::two_over_pi);
+            r = fma(q, simd_t(-traits::pio2_1), x);
+            r = fma(q, simd_t(-traits::pio2_2), r);
+            r = fma(q, simd_t(-traits::pio2_3), r);
+        }
+
+        // sin(r) for |r| <= pi/4
+        template <typename T, typename Abi>
+        inline simd<T, Abi> sin_kernel(const simd<T, Abi>& r)
+        {
+            auto z = r * r;
+            if constexpr (std::is_same_v<T, float>)
+            {
+                static constexpr float c[] = {
+                    -1.9515295891e-4f, 8.3321608736e-3f, -1.6666654611e-1f};
+                return fma(r * z, polynomial(z, c), r);
+            }
+            else
+            {
+                static constexpr double c[] = {1.58969099521155010221e-10,
+                    -2.50507602534068634195e-08, 2.75573137070700676789e-06,
+                    -1.98412698298579493134e-04, 8.33333333332248946124e-03,
+                    -1.66666666666666324348e-01};
+                return fma(r * z, polynomial(z, c), r);
+            }
+        }
+
+        // cos(r) for |r| <= pi/4
+        template <typename T, typename Abi>
+        inline simd<T, Abi> cos_kernel(const simd<T, Abi>& r)
+        {
+            auto z = r * r;
+            simd<T, Abi> tail;
+            if constexpr (std::is_same_v<T, float>)
+            {
+                static constexpr float c[] = {2.443315711809948e-5f,
+                    -1.388731625493765e-3f, 4.166664568298827e-2f};
+                tail = z * z * polynomial(z, c);
+            }
+            else
+            {
+                static constexpr double c[] = {-1.13596475577881948265e-11,
+                    2.08757232129817482790e-09, -2.75573143513906633035e-07,
+                    2.48015872894767294178e-05, -1.38888888888741095749e-03,
+                    4.16666666666666019037e-02};
+                tail = z * z * polynomial(z, c);
+            }
+            // 1 - z/2 + tail, keeping the rounding error of 1 - z/2
+            auto hz = z * T(0.5);
+            auto w = T(1) - hz;
+            return w + (((T(1) - w) - hz) + tail);
+        }
+
+        // Select the kernel result for quadrant q of sin(x + q * pi/2)
+        template <typename T, typename Abi>
+        inline simd<T, Abi> trig_quadrant(const simd<T, Abi>& q,
+            const simd<T, Abi>& sin_r, const simd<T, Abi>& cos_r)
+        {
+            using int_t = typename float_traits<T>::int_type;
+            using simd_i = simd<int_t, Abi>;
+            using mask_t = simd_mask<T, Abi>;
+
+            auto qi = static_simd_cast<int_t>(q);
+            auto odd = mask_t((qi & 1) != simd_i(0));
+            auto negate = mask_t((qi & 2) != simd_i(0));
+            auto result = choose(odd, cos_r, sin_r);
+            return choose(negate, -result, result);
+        }
+
+        // Recompute lanes that are too large for the vector reduction
+        template <typename T, typename Abi, typename F>
+        inline void trig_large_arguments(
+            const simd<T, Abi>& x, simd<T, Abi>& result, F scalar_fn)
+        {
+            auto large =
+                abs(x) > simd<T, Abi>(float_traits<T>::trig_max) && x == x;
+            if (any_of(large))
+            {
+                for (int i = 0; i < (int) x.size(); i++)
+                {
+                    if (large[i])
+                        result.set(i, scalar_fn(x[i]));
+                }
+            }
+        }
+    }    // namespace math_impl
+
+    // ----------------------------------------------------------------------
+    // exponentials and logarithms
+    // ----------------------------------------------------------------------
+    template <typename T, typename Abi>
+    inline simd<T, Abi> exp(const simd<T, Abi>& x)
+    {
+        static_assert(std::is_floating_point_v<T>,
+            "exp only works for floating point types");
+        using simd_t = simd<T, Abi>;
+        using traits = math_impl::float_traits<T>;
+
+        // clamping keeps n in range, the result saturates to 0 or inf
+        auto xc = min(max(x, simd_t(traits::exp_min)), simd_t(traits::exp_max));
+        auto n = math_impl::round_to_integral(xc * traits::log2e);
+        auto r = fma(n, simd_t(-traits::ln2_hi), xc);
+        r = fma(n, simd_t(-traits::ln2_lo), r);
+
+        auto result = math_impl::scale_by_pow2(math_impl::exp_kernel(r), n);
+        return choose(x != x, x, result);
+    }
+
+    template <typename T, typename Abi>
+    inline simd<T, Abi> exp2(const simd<T, Abi>& x)
+    {
+        static_assert(std::is_floating_point_v<T>,
+            "exp2 only works for floating point types");
+        using simd_t = simd<T, Abi>;
+        using traits = math_impl::float_traits<T>;
+
+        auto xc =
+            min(max(x, simd_t(traits::exp2_min)), simd_t(traits::exp2_max));
+        auto n = math_impl::round_to_integral(xc);
+        // x - n is exact, so the only rounding is in the scaling by ln(2)
+        auto r = (xc - n) * T(0.693147180559945309);
+
+        auto result = math_impl::scale_by_pow2(math_impl::exp_kernel(r), n);
+        return choose(x != x, x, result);
+    }
+
+    template <typename T, typename Abi>
+    inline simd<T, Abi> log(const simd<T, Abi>& x)
+    {
+        static_assert(std::is_floating_point_v<T>,
+            "log only works for floating point types");
+        using traits = math_impl::float_traits<T>;
+
+        simd<T, Abi> k, f, hfsq, correction;
+        math_impl::log_reduce(x, k, f);
+        math_impl::log_kernel(f, hfsq, correction);
+
+        auto result = k * traits::ln2_hi -
+            ((hfsq - (correction + k * traits::ln2_lo)) - f);
+        return math_impl::log_special_cases(x, result);
+    }
+
+    template <typename T, typename Abi>
+    inline simd<T, Abi> log2(const simd<T, Abi>& x)
+    {
+        static_assert(std::is_floating_point_v<T>,
+            "log2 only works for floating point types");
+        using traits = math_impl::float_traits<T>;
+
+        simd<T, Abi> k, f, hfsq, correction;
+        math_impl::log_reduce(x, k, f);
+        math_impl::log_kernel(f, hfsq, correction);
+
+        // exact for powers of two since f == 0 there
+        auto result = fma(f - (hfsq - correction), simd<T, Abi>(traits::log2e), k);
+        return math_impl::log_special_cases(x, result);
+    }
+
+    template <typename T, typename Abi>
+    inline simd<T, Abi> log10(const simd<T, Abi>& x)
+    {
+        static_assert(std::is_floating_point_v<T>,
+            "log10 only works for floating point types");
+        using traits = math_impl::float_traits<T>;
+
+        simd<T, Abi> k, f, hfsq, correction;
+        math_impl::log_reduce(x, k, f);
+        math_impl::log_kernel(f, hfsq, correction);
+
+        auto log1p_f = f - (hfsq - correction);
+        // k * log10_2_hi is exact, the low part is folded into the tail
+        auto tail = fma(log1p_f, simd<T, Abi>(traits::log10e),
+            k * traits::log10_2_lo);
+        auto result = fma(k, simd<T, Abi>(traits::log10_2_hi), tail);
+        return math_impl::log_special_cases(x, result);
+    }
+
+    template <typename T, typename Abi>
+    inline simd<T, Abi> pow(const simd<T, Abi>& x, const simd<T, Abi>& y)
+    {
+        static_assert(std::is_floating_point_v<T>,
+            "pow only works for floating point types");
+        using simd_t = simd<T, Abi>;
+        using traits = math_impl::float_traits<T>;
+        using int_t = typename traits::int_type;
+        using simd_i = simd<int_t, Abi>;
+        using mask_t = simd_mask<T, Abi>;
+
+        // |x|^y = exp(y * log|x|) with log|x| carried in extra precision
+        simd_t log_hi, log_lo;
+        math_impl::log_hi_lo(abs(x), log_hi, log_lo);
+        auto p_hi = y * log_hi;
+        auto p_lo = fma(y, log_hi, -p_hi) + y * log_lo;
+        auto e = exp(p_hi);
+        auto result =
+            choose(abs(p_hi) < simd_t(traits::exp_max), fma(e, p_lo, e), e);
+
+        // parity of y, values at or above 2^(mantissa_bits + 1) are even
+        const simd_t inf(std::numeric_limits<T>::infinity());
+        const simd_t one(T(1));
+        auto y_large =
+            abs(y) >= simd_t(T(int64_t(1) << (traits::mantissa_bits + 1)));
+        auto y_trunc = static_simd_cast<int_t>(y);
+        auto y_is_int = y_large || static_simd_cast<T>(y_trunc) == y;
+        auto y_is_odd = !y_large && y_is_int &&
+            mask_t((y_trunc & 1) != simd_i(0));
+
+        // a zero base gives 0 for y > 0 and inf for y < 0, an infinite
+        // base the other way round, the sign follows from the odd y rule
+        const simd_t zero(T(0));
+        auto x_zero = abs(x) == zero;
+        auto x_inf = abs(x) == inf;
+        result = choose(x_zero || x_inf,
+            choose((x_zero && y > zero) || (x_inf && y < zero), zero, inf),
+            result);
+
+        auto x_negative = mask_t(simd_bit_cast<int_t>(x) < simd_i(0));
+        result = choose(x_negative && y_is_odd, -result, result);
+        result = choose(x < zero && x > -inf && !y_is_int,
+            simd_t(std::numeric_limits<T>::quiet_NaN()), result);
+        result = choose(abs(x) == one && abs(y) == inf, one, result);
+        result = choose(x != x || y != y, x + y, result);
+        return choose(y == zero || x == one, one, result);
+    }
+
+    // ----------------------------------------------------------------------
+    // trigonometric and hyperbolic functions
+    // ----------------------------------------------------------------------
+    template <typename T, typename Abi>
+    inline simd<T, Abi> sin(const simd<T, Abi>& x)
+    {
+        static_assert(std::is_floating_point_v<T>,
+            "sin only works for floating point types");
+        simd<T, Abi> q, r;
+        math_impl::trig_reduce(x, q, r);
+        auto result = math_impl::trig_quadrant(
+            q, math_impl::sin_kernel(r), math_impl::cos_kernel(r));
+        math_impl::trig_large_arguments(
+            x, result, [](T v) { return std::sin(v); });
+        // sin(-0) is -0
+        return choose(x == simd<T, Abi>(T(0)), x, result);
+    }
+
+    template <typename T, typename Abi>
+    inline simd<T, Abi> cos(const simd<T, Abi>& x)
+    {
+        static_assert(std::is_floating_point_v<T>,
+            "cos only works for floating point types");
+        simd<T, Abi> q, r;
+        math_impl::trig_reduce(x, q, r);
+        // cos(x) = sin(x + pi/2)
+        auto result = math_impl::trig_quadrant(
+            q + T(1), math_impl::sin_kernel(r), math_impl::cos_kernel(r));
+        math_impl::trig_large_arguments(
+            x, result, [](T v) { return std::cos(v); });
+        return result;
+    }
+
+    template <typename T, typename Abi>
+    inline simd<T, Abi> tanh(const simd<T, Abi>& x)
+    {
+        static_assert(std::is_floating_point_v<T>,
+            "tanh only works for floating point types");
+        using simd_t = simd<T, Abi>;
+
+        auto ax = abs(x);
+        auto z = x * x;
+        auto small = ax < simd_t(T(0.625));
+
+        // |x| < 0.625: odd rational / polynomial approximation (cephes)
+        simd_t result_small;
+        if constexpr (std::is_same_v<T, float>)
+        {
+            static constexpr float c[] = {-5.70498872745e-3f,
+                2.06390887954e-2f, -5.37397155531e-2f, 1.33314422036e-1f,
+                -3.33332819422e-1f};
+            result_small = fma(z * x, math_impl::polynomial(z, c), x);
+        }
+        else
+        {
+            static constexpr double p[] = {-9.64399179425052238628e-1,
+                -9.92877231001918586564e1, -1.61468768441708447952e3};
+            static constexpr double q[] = {1.0, 1.12811678491632931402e2,
+                2.23548839060100448583e3, 4.84406305325125486048e3};
+            result_small = fma(z * x,
+                math_impl::polynomial(z, p) / math_impl::polynomial(z, q), x);
+        }
+
+        // otherwise 1 - 2 / (exp(2|x|) + 1), which saturates to 1
+        auto result_large =
+            copysign(T(1) - T(2) / (exp(ax + ax) + T(1)), x);
+        result_small = choose(x == simd_t(T(0)), x, result_small);
+        return choose(small, result_small, result_large);
+    }
+
+    template <typename T, typename Abi>
+    inline simd<T, Abi> erf(const simd<T, Abi>& x)
+    {
+        static_assert(std::is_floating_point_v<T>,
+            "erf only works for floating point types");
+        using simd_t = simd<T, Abi>;
+        using traits = math_impl::float_traits<T>;
+
+        auto ax = abs(x);
+        auto z = x * x;
+        auto small = ax < simd_t(T(0.84375));
+
+        simd_t result;
+        if constexpr (std::is_same_v<T, float>)
+        {
+            // Taylor series of erf(x) / x in x^2
+            static constexpr float c[] = {-1.6365844146548625e-07f,
+                1.6462114444948384e-06f, -1.4925650248187594e-05f,
+                0.00012055332626914605f, -0.0008548327023163438f,
+                0.005223977845162153f, -0.02686617150902748f,
+                0.11283791810274124f, -0.37612637877464294f,
+                1.128379225730896f};
+            result = x * math_impl::polynomial(z, c);
+        }
+        else
+        {
+            // erf(x) = x + x * P(x^2) / Q(x^2), see fdlibm's s_erf.c
+            static constexpr double p[] = {-2.37630166566501626084e-05,
+                -5.77027029648944159157e-03, -2.84817495755985104766e-02,
+                -3.25042107247001499370e-01, 1.28379167095512558561e-01};
+            static constexpr double q[] = {-3.96022827877536812320e-06,
+                1.32494738004321644526e-04, 5.08130628187576562776e-03,
+                6.50222499887672944485e-02, 3.97917223959155352819e-01, 1.0};
+            result = fma(x,
+                math_impl::polynomial(z, p) / math_impl::polynomial(z, q), x);
+        }
+
+        auto large = !small && ax < simd_t(traits::erf_one);
+        if (any_of(large))
+        {
+            // erf(x) = 1 - exp(-x^2) * erfcx(x), with erfcx = exp(x^2) erfc(x)
+            // approximated by Chebyshev fits on the scaled interval t
+            simd_t erfcx;
+            if constexpr (std::is_same_v<T, float>)
+            {
+                static constexpr float c[] = {3.340377224958502e-05f,
+                    -8.666526264278218e-05f, 0.00011168665514560416f,
+                    -0.00026607184554450214f, 0.0007513860473409295f,
+                    -0.0017320230836048722f, 0.003798568621277809f,
+                    -0.00821822602301836f, 0.01720573566854f,
+                    -0.03466382622718811f, 0.06701211631298065f,
+                    -0.12371749430894852f, 0.21677087247371674f};
+                erfcx = math_impl::polynomial(
+                    (ax - 2.421875f) * (1 / 1.578125f), c);
+            }
+            else
+            {
+                static constexpr double c0[] = {-4.627665072111247e-13,
+                    3.025133466281204e-12, -1.7265904218264645e-11,
+                    1.0733066251675908e-10, -6.548004579852381e-10,
+                    3.870727903553027e-09, -2.2251151691551715e-08,
+                    1.2420159089048956e-07, -6.716311439684681e-07,
+                    3.5098888491637744e-06, -1.76751645479721e-05,
+                    8.547720668268377e-05, -0.0003953198787355054,
+                    0.0017395076316354618, -0.0072352065405091575,
+                    0.028203788853347886, -0.10183730171958434,
+                    0.3348494624055177};
+                static constexpr double c1[] = {-1.4307261790948654e-13,
+                    8.908801922505171e-13, -4.813392632169323e-12,
+                    2.885538557548928e-11, -1.7108134429655407e-10,
+                    9.88787353635382e-10, -5.601435958505965e-09,
+                    3.108358578398941e-08, -1.68743335231591e-07,
+                    8.950251220332474e-07, -4.631705268994185e-06,
+                    2.3347542127786593e-05, -0.00011442715395558115,
+                    0.0005440864558930353, -0.002503548800296017,
+                    0.011114208555369083, -0.04742822817047613,
+                    0.1936620962790687};
+                static constexpr double c2[] = {-1.2076133879485765e-12,
+                    6.0017285207420495e-12, -2.4082305647505305e-11,
+                    1.1659734513230457e-10, -5.683273767282097e-10,
+                    2.69124740381947e-09, -1.2581478025813186e-08,
+                    5.8136004948863275e-08, -2.6520906571518573e-07,
+                    1.1938335877076895e-06, -5.300367911976062e-06,
+                    2.31976109662253e-05, -0.00010002374613996337,
+                    0.00042462964854467103, -0.0017736306582610557,
+                    0.007283322451518984, -0.02937931074770394,
+                    0.11630270721024731};
+                // intervals [0.84375, 2), [2, 3.5), [3.5, 6)
+                auto in_first = ax < simd_t(2.0);
+                auto in_second = ax < simd_t(3.5);
+                erfcx = math_impl::polynomial((ax - 4.75) * (1 / 1.25), c2);
+                if (any_of(large && in_second))
+                {
+                    erfcx = choose(in_second,
+                        math_impl::polynomial((ax - 2.75) * (1 / 0.75), c1),
+                        erfcx);
+                }
+                if (any_of(large && in_first))
+                {
+                    erfcx = choose(in_first,
+                        math_impl::polynomial(
+                            (ax - 1.421875) * (1 / 0.578125), c0),
+                        erfcx);
+                }
+            }
+            // exp(-x^2) with the rounding error of x^2 folded back in
+            auto z_err = fma(ax, ax, -z);
+            auto e = exp(-z);
+            e = fma(-e, z_err, e);
+            auto result_large = copysign(fma(-e, erfcx, simd_t(T(1))), x);
+            result = choose(large, result_large, result);
+        }
+        auto saturated = ax >= simd_t(traits::erf_one);
+        return choose(saturated, copysign(simd_t(T(1)), x), result);
+    }
+
+    // ----------------------------------------------------------------------
+    // fast, reduced accuracy variants (no special value handling)
+    // ----------------------------------------------------------------------
+    // Inputs are clamped to the range where the result is a normal number.
+    template <typename T, typename Abi>
+    inline simd<T, Abi> fast_exp(const simd<T, Abi>& x)
+    {
+        static_assert(std::is_floating_point_v<T>,
+            "fast_exp only works for floating point types");
+        using simd_t = simd<T, Abi>;
+        using traits = math_impl::float_traits<T>;
+        using int_t = typename traits::int_type;
+
+        auto xc = min(max(x, simd_t(traits::fast_exp_min)),
+            simd_t(traits::fast_exp_max));
+        auto n = math_impl::round_to_integral(xc * traits::log2e);
+        auto r = fma(n, simd_t(T(-traits::ln2_hi - traits::ln2_lo)), xc);
+
+        // single precision minimax polynomial, also used for double
+        static constexpr T c[] = {T(1.9875691500e-4), T(1.3981999507e-3),
+            T(8.3334519073e-3), T(4.1665795894e-2), T(1.6666665459e-1),
+            T(5.0000001201e-1)};
+        auto p = fma(math_impl::polynomial(r, c), r * r, r + T(1));
+        // add n to the exponent field directly
+        auto bits = simd_bit_cast<int_t>(p) +
+            (static_simd_cast<int_t>(n) << traits::mantissa_bits);
+        return simd_bit_cast<T>(bits);
+    }
+
+    // Valid for positive normal inputs.
+    template <typename T, typename Abi>
+    inline simd<T, Abi> fast_log(const simd<T, Abi>& x)
+    {
+        static_assert(std::is_floating_point_v<T>,
+            "fast_log only works for floating point types");
+        using traits = math_impl::float_traits<T>;
+        using int_t = typename traits::int_type;
+
+        auto ix = simd_bit_cast<int_t>(x);
+        ix += traits::one_bits - traits::sqrt_half_bits;
+        auto k = static_simd_cast<T>(
+            (ix >> traits::mantissa_bits) - traits::exponent_bias);
+        ix = (ix & traits::mantissa_mask) + traits::sqrt_half_bits;
+        auto m = simd_bit_cast<T>(ix);
+
+        // log(m) = 2 atanh(s), s = (m - 1) / (m + 1)
+        auto s = (m - T(1)) / (m + T(1));
+        static constexpr T c[] = {T(2.0 / 7), T(2.0 / 5), T(2.0 / 3), T(2)};
+        auto log_m = s * math_impl::polynomial(s * s, c);
+        return fma(k, simd<T, Abi>(T(traits::ln2_hi + traits::ln2_lo)), log_m);
+    }
+
+    // Valid for |x| up to about 1e4.
+    template <typename T, typename Abi>
+    inline simd<T, Abi> fast_sin(const simd<T, Abi>& x)
+    {
+        static_assert(std::is_floating_point_v<T>,
+            "fast_sin only works for floating point types");
+        using simd_t = simd<T, Abi>;
+        using traits = math_impl::float_traits<T>;
+
+        auto q = math_impl::round_to_integral(x * traits::two_over_pi);
+        auto r = fma(q, simd_t(-traits::pio2_1), x);
+        r = fma(q, simd_t(-traits::pio2_2), r);
+        auto z = r * r;
+
+        static constexpr T s[] = {T(-1.0 / 5040), T(1.0 / 120), T(-1.0 / 6)};
+        static constexpr T c[] = {
+            T(1.0 / 40320), T(-1.0 / 720), T(1.0 / 24), T(-0.5), T(1)};
+        return math_impl::trig_quadrant(q,
+            fma(r * z, math_impl::polynomial(z, s), r),
+            math_impl::polynomial(z, c));
+    }
+
+    // Valid for |x| up to about 1e4.
+    template <typename T, typename Abi>
+    inline simd<T, Abi> fast_cos(const simd<T, Abi>& x)
+    {
+        static_assert(std::is_floating_point_v<T>,
+            "fast_cos only works for floating point types");
+        using simd_t = simd<T, Abi>;
+        using traits = math_impl::float_traits<T>;
+
+        auto q = math_impl::round_to_integral(x * traits::two_over_pi);
+        auto r = fma(q, simd_t(-traits::pio2_1), x);
+        r = fma(q, simd_t(-traits::pio2_2), r);
+        auto z = r * r;
+
+        static constexpr T s[] = {T(-1.0 / 5040), T(1.0 / 120), T(-1.0 / 6)};
+        static constexpr T c[] = {
+            T(1.0 / 40320), T(-1.0 / 720), T(1.0 / 24), T(-0.5), T(1)};
+        return math_impl::trig_quadrant(q + T(1),
+            fma(r * z, math_impl::polynomial(z, s), r),
+            math_impl::polynomial(z, c));
+    }
+}}    // namespace rvv::experimental::parallelism_v2
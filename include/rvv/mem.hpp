@@ -0,0 +1,102 @@
+#pragma once
+
+#include <rvv/rvv.hpp>
+#include <cstddef>
+#include <cstdint>
+
+// memcpy, memset, memcmp, memchr and strlen on byte vectors.
+//
+// All loops run on groups of eight vector registers (e8, LMUL=8) with vl
+// set from the remaining size, so the tail needs no scalar code. The search
+// loops look for the first matching lane with vfirst on the compare mask.
+// strlen does not know the size of its input and reads with fault-only-
+// first loads, which shorten vl instead of faulting on an unmapped page
+// past the terminator.
+
+namespace rvv::mem {
+
+    // copies size bytes from src to dst, the ranges must not overlap
+    inline void* copy(void* dst, const void* src, std::size_t size)
+    {
+        auto* d = static_cast<uint8_t*>(dst);
+        const auto* s = static_cast<const uint8_t*>(src);
+        while (size > 0)
+        {
+            std::size_t vl = __riscv_vsetvl_e8m8(size);
+            __riscv_vse8(d, __riscv_vle8_v_u8m8(s, vl), vl);
+            d += vl;
+            s += vl;
+            size -= vl;
+        }
+        return dst;
+    }
+
+    // sets size bytes at dst to value
+    inline void* set(void* dst, uint8_t value, std::size_t size)
+    {
+        auto* d = static_cast<uint8_t*>(dst);
+        const auto x = __riscv_vmv_v_x_u8m8(value, __riscv_vsetvlmax_e8m8());
+        while (size > 0)
+        {
+            std::size_t vl = __riscv_vsetvl_e8m8(size);
+            __riscv_vse8(d, x, vl);
+            d += vl;
+            size -= vl;
+        }
+        return dst;
+    }
+
+    // Compares size bytes as unsigned values, returns the difference of the
+    // first differing pair or 0 if the ranges are equal
+    inline int compare(const void* lhs, const void* rhs, std::size_t size)
+    {
+        const auto* a = static_cast<const uint8_t*>(lhs);
+        const auto* b = static_cast<const uint8_t*>(rhs);
+        while (size > 0)
+        {
+            std::size_t vl = __riscv_vsetvl_e8m8(size);
+            auto ne = __riscv_vmsne(
+                __riscv_vle8_v_u8m8(a, vl), __riscv_vle8_v_u8m8(b, vl), vl);
+            long i = __riscv_vfirst(ne, vl);
+            if (i >= 0)
+                return int(a[i]) - int(b[i]);
+            a += vl;
+            b += vl;
+            size -= vl;
+        }
+        return 0;
+    }
+
+    // first occurrence of value in the size bytes at p, nullptr if none
+    inline const void* find(const void* p, uint8_t value, std::size_t size)
+    {
+        const auto* s = static_cast<const uint8_t*>(p);
+        while (size > 0)
+        {
+            std::size_t vl = __riscv_vsetvl_e8m8(size);
+            auto eq = __riscv_vmseq(__riscv_vle8_v_u8m8(s, vl), value, vl);
+            long i = __riscv_vfirst(eq, vl);
+            if (i >= 0)
+                return s + i;
+            s += vl;
+            size -= vl;
+        }
+        return nullptr;
+    }
+
+    // length of the null terminated string at str
+    inline std::size_t strlen(const char* str)
+    {
+        const auto* s = reinterpret_cast<const uint8_t*>(str);
+        const std::size_t vlmax = __riscv_vsetvlmax_e8m8();
+        for (;;)
+        {
+            std::size_t vl;
+            auto x = __riscv_vle8ff_v_u8m8(s, &vl, vlmax);
+            long i = __riscv_vfirst(__riscv_vmseq(x, uint8_t(0), vl), vl);
+            if (i >= 0)
+                return std::size_t(s + i - reinterpret_cast<const uint8_t*>(str));
+            s += vl;
+        }
+    }
+}    // namespace rvv::mem
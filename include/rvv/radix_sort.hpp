@@ -0,0 +1,209 @@
+#pragma once
+
+#include <rvv/rvv.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <ranges>
+#include <type_traits>
+#include <vector>
+
+// LSD radix sort of 32 and 64-bit integer and floating point keys, with an
+// optional array of values that is permuted along with the keys.
+//
+// The keys are mapped in place to unsigned integers with the same order
+// (sign bit flipped, negative floats inverted) and sorted by 8-bit digits.
+// To keep the sort stable while every lane writes on its own, the range is
+// cut into one contiguous block per lane, read with strided loads, and each
+// lane keeps its own column of the digit counts. Gathering and scattering
+// the counts through those columns never collides between lanes, and the
+// (digit, lane) order of the output positions is the input order. The
+// elements after the last full block row go through scalar code as one more
+// column. Every pass counts its input once and scatters it once, passes in
+// which all keys share the digit are skipped.
+//
+// Keys and values are uint32_t, int32_t, float or uint64_t, int64_t, double,
+// values have the width of the keys. Output positions are 32-bit element
+// indices for 32-bit keys, which the simd layer scales to byte offsets, so
+// those are limited to 2^30 elements.
+
+namespace rvv {
+
+    namespace radix_sort_impl {
+
+        using namespace rvv::experimental;
+
+        template <typename T>
+        using key_bits = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+
+        template <typename T>
+        inline constexpr bool is_key = (sizeof(T) == 4 || sizeof(T) == 8) &&
+            (std::is_integral_v<T> || std::is_floating_point_v<T>);
+
+        // Maps the keys to unsigned integers of the same order, or back
+        template <typename T, bool Inverse>
+        inline void transform_keys(key_bits<T>* p, size_t n)
+        {
+            using U = key_bits<T>;
+            using vector = simd<U>;
+            constexpr size_t lanes = vector::size();
+            const vector sign(U(1) << (8 * sizeof(U) - 1));
+            for (size_t i = 0; i < n && !std::is_unsigned_v<T>;)
+            {
+                size_t vl = std::min(lanes, n - i);
+                vector x;
+                x.partial_copy_from(p + i, vl);
+                if constexpr (std::is_integral_v<T>)
+                    x ^= sign;
+                else
+                {
+                    // negative values have all bits inverted, the others only
+                    // the sign bit
+                    vector top = x >> int(8 * sizeof(U) - 1);
+                    vector flip = Inverse ? top - U(1) : vector(U(0)) - top;
+                    x ^= flip | sign;
+                }
+                x.partial_copy_to(p + i, vl);
+                i += vl;
+            }
+        }
+
+        inline constexpr size_t radix = 256;
+
+        // The keys may be floating point and the values any type of the key
+        // width, scalar code copies their bytes instead of reading or
+        // writing them as U, which would break strict aliasing
+        template <typename U>
+        inline U read(const U* p)
+        {
+            U x;
+            std::memcpy(&x, p, sizeof(U));
+            return x;
+        }
+
+        template <typename U>
+        inline void sort(U* keys, U* values, size_t n)
+        {
+            using vector = simd<U>;
+            constexpr size_t passes = sizeof(U);
+            constexpr size_t lanes = vector::size();
+            constexpr size_t columns = lanes + 1;
+            const size_t rows = n / lanes;
+            const vector lane(vector::index0123);
+
+            std::vector<U> buffer(n), value_buffer(values ? n : 0);
+            U* src = keys;
+            U* dst = buffer.data();
+            U* value_src = values;
+            U* value_dst = value_buffer.data();
+            std::vector<U> table(radix * columns);
+            // counter of the digit of x in the column of its lane
+            auto counter = [&](const vector& x, size_t pass) {
+                return ((x >> int(8 * pass)) & U(radix - 1)) * U(columns) +
+                    lane;
+            };
+            for (size_t pass = 0; pass < passes; pass++)
+            {
+                // digit counts per column, lane l counts src[l * rows + r]
+                std::fill(table.begin(), table.end(), U(0));
+                for (size_t r = 0; r < rows; r++)
+                {
+                    vector x;
+                    x.strided_copy_from(src + r, rows);
+                    vector index = counter(x, pass);
+                    scatter(gather(table.data(), index) + U(1), table.data(),
+                        index);
+                }
+                for (size_t i = rows * lanes; i < n; i++)
+                    table[((read(src + i) >> (8 * pass)) & (radix - 1)) * columns + lanes]++;
+
+                // exclusive prefix sum in (digit, column) order gives the
+                // output position of the first key of each column
+                bool single_digit = false;
+                U position = 0;
+                for (size_t d = 0; d < radix; d++)
+                {
+                    U digit_start = position;
+                    for (size_t k = 0; k < columns; k++)
+                    {
+                        U c = table[d * columns + k];
+                        table[d * columns + k] = position;
+                        position += c;
+                    }
+                    single_digit |= position - digit_start == n;
+                }
+                if (single_digit)
+                    continue;
+
+                for (size_t r = 0; r < rows; r++)
+                {
+                    vector x;
+                    x.strided_copy_from(src + r, rows);
+                    vector index = counter(x, pass);
+                    vector target = gather(table.data(), index);
+                    scatter(target + U(1), table.data(), index);
+                    scatter(x, dst, target);
+                    if (values)
+                    {
+                        vector v;
+                        v.strided_copy_from(value_src + r, rows);
+                        scatter(v, value_dst, target);
+                    }
+                }
+                for (size_t i = rows * lanes; i < n; i++)
+                {
+                    U& p = table[((read(src + i) >> (8 * pass)) & (radix - 1)) * columns + lanes];
+                    std::memcpy(dst + p, src + i, sizeof(U));
+                    if (values)
+                        std::memcpy(value_dst + p, value_src + i, sizeof(U));
+                    p++;
+                }
+                std::swap(src, dst);
+                std::swap(value_src, value_dst);
+            }
+            if (src != keys)
+            {
+                std::memcpy(keys, src, n * sizeof(U));
+                if (values)
+                    std::memcpy(values, value_src, n * sizeof(U));
+            }
+        }
+    }    // namespace radix_sort_impl
+
+    // sorts the keys in ascending order, negative zero before zero
+    template <std::ranges::contiguous_range Keys>
+    inline void radix_sort(Keys&& keys)
+    {
+        using T = std::ranges::range_value_t<Keys>;
+        using U = radix_sort_impl::key_bits<T>;
+        static_assert(radix_sort_impl::is_key<T>,
+            "radix_sort only works for 32 and 64-bit arithmetic types");
+        // only vector loads and stores or memcpy go through p
+        U* p = reinterpret_cast<U*>(std::ranges::data(keys));
+        const size_t n = std::ranges::size(keys);
+        radix_sort_impl::transform_keys<T, false>(p, n);
+        radix_sort_impl::sort<U>(p, nullptr, n);
+        radix_sort_impl::transform_keys<T, true>(p, n);
+    }
+
+    // sorts the keys and applies the same permutation to values, values of
+    // equal keys keep their order
+    template <std::ranges::contiguous_range Keys,
+        std::ranges::contiguous_range Values>
+    inline void radix_sort(Keys&& keys, Values&& values)
+    {
+        using T = std::ranges::range_value_t<Keys>;
+        using V = std::ranges::range_value_t<Values>;
+        using U = radix_sort_impl::key_bits<T>;
+        static_assert(radix_sort_impl::is_key<T>,
+            "radix_sort only works for 32 and 64-bit arithmetic types");
+        static_assert(sizeof(V) == sizeof(T) && std::is_trivially_copyable_v<V>,
+            "radix_sort values must have the width of the keys");
+        U* p = reinterpret_cast<U*>(std::ranges::data(keys));
+        const size_t n = std::ranges::size(keys);
+        radix_sort_impl::transform_keys<T, false>(p, n);
+        radix_sort_impl::sort<U>(
+            p, reinterpret_cast<U*>(std::ranges::data(values)), n);
+        radix_sort_impl::transform_keys<T, true>(p, n);
+    }
+}    // namespace rvv
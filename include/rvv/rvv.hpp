@@ -1,8 +1,12 @@
-
+#pragma once
 
 #include <riscv_vector.h>
+#include <algorithm>
 #include <cstddef>
+#include <bit>
+#include <cmath>
 #include <functional>
+#include <limits>
 #include <iostream>
 #include <type_traits>
 #include <unistd.h>
@@ -97,6 +101,248 @@ namespace rvv_impl {
     template<typename T>
     concept FloatingSIMD = IsAnyOf<T, _Float16, float, double>;
 
+    // reinterpret reuses the register bits of a vector of From as a vector
+    // of To, both element types must have the same width unless both are
+    // unsigned
+    template <typename To, typename From>
+    inline typename vector_type<To>::type reinterpret(
+        typename vector_type<From>::type vec)
+    {
+        static_assert(sizeof(To) == sizeof(From) ||
+                (UnignedSIMD<To> && UnignedSIMD<From>),
+            "reinterpret requires element types of the same width");
+        if constexpr (std::is_same_v<To, From>)
+            return vec;
+        else if constexpr (std::is_same_v<To, int8_t>)
+            return __riscv_vreinterpret_i8m1(vec);
+        else if constexpr (std::is_same_v<To, int16_t>)
+            return __riscv_vreinterpret_i16m1(vec);
+        else if constexpr (std::is_same_v<To, int32_t>)
+            return __riscv_vreinterpret_i32m1(vec);
+        else if constexpr (std::is_same_v<To, int64_t>)
+            return __riscv_vreinterpret_i64m1(vec);
+        else if constexpr (std::is_same_v<To, uint8_t>)
+            return __riscv_vreinterpret_u8m1(vec);
+        else if constexpr (std::is_same_v<To, uint16_t>)
+            return __riscv_vreinterpret_u16m1(vec);
+        else if constexpr (std::is_same_v<To, uint32_t>)
+            return __riscv_vreinterpret_u32m1(vec);
+        else if constexpr (std::is_same_v<To, uint64_t>)
+            return __riscv_vreinterpret_u64m1(vec);
+        else if constexpr (std::is_same_v<To, _Float16>)
+            return __riscv_vreinterpret_f16m1(vec);
+        else if constexpr (std::is_same_v<To, float>)
+            return __riscv_vreinterpret_f32m1(vec);
+        else
+            return __riscv_vreinterpret_f64m1(vec);
+    }
+
+    // convert performs an element-wise value conversion between element
+    // types of the same width. Floating to integral conversion truncates
+    // towards zero (like static_cast) and saturates on overflow.
+    template <typename To, typename From>
+    inline typename vector_type<To>::type convert(
+        typename vector_type<From>::type vec, size_t size)
+    {
+        static_assert(sizeof(To) == sizeof(From),
+            "convert requires element types of the same width");
+        if constexpr (FloatingSIMD<To> == FloatingSIMD<From>)
+            return reinterpret<To, From>(vec);
+        else if constexpr (FloatingSIMD<To>)
+            return __riscv_vfcvt_f(vec, size);
+        else if constexpr (SignedSIMD<To>)
+            return __riscv_vfcvt_rtz_x(vec, size);
+        else
+            return __riscv_vfcvt_rtz_xu(vec, size);
+    }
+
+    // integral_of is the signed integral type with the width of T
+    template <typename T>
+    using integral_of = std::conditional_t<sizeof(T) == 2, int16_t,
+        std::conditional_t<sizeof(T) == 4, int32_t, int64_t>>;
+
+    // index_of is the unsigned integral type with the width of T, the type
+    // of the lane indices of a gather
+    template <typename T>
+    using index_of = std::conditional_t<sizeof(T) == 1, uint8_t,
+        std::conditional_t<sizeof(T) == 2, uint16_t,
+            std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>>;
+
+    // floating_of is the floating type with the width of T
+    template <typename T>
+    using floating_of = std::conditional_t<sizeof(T) == 2, _Float16,
+        std::conditional_t<sizeof(T) == 4, float, double>>;
+
+    // convert_rounding converts floating elements to integral elements of
+    // the same width using the static rounding mode Frm (one of
+    // __RISCV_FRM_*), saturating on overflow. Frm > __RISCV_FRM_RMM uses the
+    // dynamic rounding mode from the frm register.
+    template <typename To, typename From, unsigned Frm>
+    inline typename vector_type<To>::type convert_rounding(
+        typename vector_type<From>::type vec, size_t size)
+    {
+        static_assert(sizeof(To) == sizeof(From),
+            "convert_rounding requires element types of the same width");
+        static_assert(FloatingSIMD<From> && !FloatingSIMD<To>,
+            "convert_rounding converts from floating to integral types");
+        if constexpr (Frm > __RISCV_FRM_RMM)
+        {
+            if constexpr (SignedSIMD<To>)
+                return __riscv_vfcvt_x(vec, size);
+            else
+                return __riscv_vfcvt_xu(vec, size);
+        }
+        else if constexpr (SignedSIMD<To>)
+            return __riscv_vfcvt_x(vec, Frm, size);
+        else
+            return __riscv_vfcvt_xu(vec, Frm, size);
+    }
+
+    // Bit manipulation on unsigned element types. With Zvbb these map to
+    // single instructions, otherwise they are emulated with shifts and
+    // nibble lookup tables (vrgather on the bytes of the vector).
+    inline constexpr uint8_t nibble_popcount[16] = {
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4};
+    inline constexpr uint8_t nibble_reverse[16] = {
+        0x0, 0x8, 0x4, 0xc, 0x2, 0xa, 0x6, 0xe,
+        0x1, 0x9, 0x5, 0xd, 0x3, 0xb, 0x7, 0xf};
+
+    template <typename U>
+    inline typename vector_type<U>::type popcount(
+        typename vector_type<U>::type vec, size_t size)
+    {
+#if defined(__riscv_zvbb)
+        return __riscv_vcpop(vec, size);
+#else
+        const size_t bytes = size * sizeof(U);
+        auto b = reinterpret<uint8_t, U>(vec);
+        auto table = __riscv_vle8_v_u8m1(nibble_popcount, 16);
+        auto lo = __riscv_vrgather(table, __riscv_vand(b, 0xf, bytes), bytes);
+        auto hi = __riscv_vrgather(table, __riscv_vsrl(b, 4, bytes), bytes);
+        auto counts = reinterpret<U, uint8_t>(__riscv_vadd(lo, hi, bytes));
+        // sum the per byte counts into the lowest byte of each element
+        for (size_t shift = 8; shift < sizeof(U) * 8; shift *= 2)
+            counts = __riscv_vadd(counts, __riscv_vsrl(counts, shift, size), size);
+        return __riscv_vand(counts, 0xff, size);
+#endif
+    }
+
+    template <typename U>
+    inline typename vector_type<U>::type countl_zero(
+        typename vector_type<U>::type vec, size_t size)
+    {
+#if defined(__riscv_zvbb)
+        return __riscv_vclz(vec, size);
+#else
+        // set all bits below the highest set bit, then count the zeros
+        for (size_t shift = 1; shift < sizeof(U) * 8; shift *= 2)
+            vec = __riscv_vor(vec, __riscv_vsrl(vec, shift, size), size);
+        return popcount<U>(__riscv_vnot(vec, size), size);
+#endif
+    }
+
+    template <typename U>
+    inline typename vector_type<U>::type countr_zero(
+        typename vector_type<U>::type vec, size_t size)
+    {
+#if defined(__riscv_zvbb)
+        return __riscv_vctz(vec, size);
+#else
+        // ~x & (x - 1) has exactly the trailing zero bits of x set
+        auto below = __riscv_vsub(vec, 1, size);
+        return popcount<U>(
+            __riscv_vand(__riscv_vnot(vec, size), below, size), size);
+#endif
+    }
+
+    template <typename U>
+    inline typename vector_type<U>::type byteswap(
+        typename vector_type<U>::type vec, size_t size)
+    {
+        if constexpr (sizeof(U) == 1)
+            return vec;
+#if defined(__riscv_zvbb)
+        else
+            return __riscv_vrev8(vec, size);
+#else
+        else
+        {
+            // byte i of the result is byte i ^ (sizeof(U) - 1) of vec
+            const size_t bytes = size * sizeof(U);
+            auto index = __riscv_vxor(
+                __riscv_vid_v_u8m1(bytes), sizeof(U) - 1, bytes);
+            return reinterpret<U, uint8_t>(__riscv_vrgather(
+                reinterpret<uint8_t, U>(vec), index, bytes));
+        }
+#endif
+    }
+
+    template <typename U>
+    inline typename vector_type<U>::type bit_reverse(
+        typename vector_type<U>::type vec, size_t size)
+    {
+#if defined(__riscv_zvbb)
+        return __riscv_vbrev(vec, size);
+#else
+        // reverse the bits within each byte, then the bytes
+        const size_t bytes = size * sizeof(U);
+        auto b = reinterpret<uint8_t, U>(vec);
+        auto table = __riscv_vle8_v_u8m1(nibble_reverse, 16);
+        auto lo = __riscv_vrgather(table, __riscv_vand(b, 0xf, bytes), bytes);
+        auto hi = __riscv_vrgather(table, __riscv_vsrl(b, 4, bytes), bytes);
+        auto reversed = __riscv_vor(__riscv_vsll(lo, 4, bytes), hi, bytes);
+        return byteswap<U>(reinterpret<U, uint8_t>(reversed), size);
+#endif
+    }
+
+    template <typename U>
+    inline typename vector_type<U>::type andn(typename vector_type<U>::type x,
+        typename vector_type<U>::type y, size_t size)
+    {
+#if defined(__riscv_zvbb)
+        return __riscv_vandn(x, y, size);
+#else
+        return __riscv_vand(x, __riscv_vnot(y, size), size);
+#endif
+    }
+
+    // Carry-less multiplication of 64-bit elements, clmul returns the low
+    // and clmulh the high 64 bits of the 128-bit product. Without Zvbc the
+    // product is accumulated one bit of y at a time.
+    inline vuint64m1_t clmul(vuint64m1_t x, vuint64m1_t y, size_t size)
+    {
+#if defined(__riscv_zvbc)
+        return __riscv_vclmul(x, y, size);
+#else
+        auto result = __riscv_vmv_v_x_u64m1(0, size);
+        for (size_t bit = 0; bit < 64; bit++)
+        {
+            auto set = __riscv_vmsne(
+                __riscv_vand(y, uint64_t(1) << bit, size), 0, size);
+            result = __riscv_vxor_mu(
+                set, result, result, __riscv_vsll(x, bit, size), size);
+        }
+        return result;
+#endif
+    }
+
+    inline vuint64m1_t clmulh(vuint64m1_t x, vuint64m1_t y, size_t size)
+    {
+#if defined(__riscv_zvbc)
+        return __riscv_vclmulh(x, y, size);
+#else
+        auto result = __riscv_vmv_v_x_u64m1(0, size);
+        for (size_t bit = 1; bit < 64; bit++)
+        {
+            auto set = __riscv_vmsne(
+                __riscv_vand(y, uint64_t(1) << bit, size), 0, size);
+            result = __riscv_vxor_mu(
+                set, result, result, __riscv_vsrl(x, 64 - bit, size), size);
+        }
+        return result;
+#endif
+    }
+
     // simd_impl_base implements functions where intrinsic's 
     // signature differs for signed,unsigned and floating types
     template <typename T>
@@ -131,11 +377,37 @@ namespace rvv_impl {
             return __riscv_vmul(x, y, size);
         }
 
+        inline static Vector multiply_high(auto x, auto y, size_t size)
+        {
+            return __riscv_vmulh(x, y, size);
+        }
+
+        // signed x times unsigned y
+        inline static Vector multiply_high_su(auto x, auto y, size_t size)
+        {
+            return __riscv_vmulhsu(x, y, size);
+        }
+
         inline static Vector divide(auto x, auto y, size_t size)
         {
             return __riscv_vdiv(x, y, size);
         }
 
+        inline static Vector fma(auto x, auto y, auto z, size_t size)
+        {
+            return __riscv_vmadd(x, y, z, size);
+        }
+
+        inline static Vector shift_left(auto x, size_t n, size_t size)
+        {
+            return __riscv_vsll(x, n, size);
+        }
+
+        inline static Vector shift_right(auto x, size_t n, size_t size)
+        {
+            return __riscv_vsra(x, n, size);
+        }
+
         inline static Vector min(auto x, auto y, size_t size)
         {
             return __riscv_vmin(x, y, size);
@@ -146,6 +418,30 @@ namespace rvv_impl {
             return __riscv_vmax(x, y, size);
         }
 
+        // lane i of the result is lane idx[i] of x
+        inline static Vector gather(auto x, auto idx, size_t size)
+        {
+            return __riscv_vrgather(x, idx, size);
+        }
+
+        // lane i of the result is lane i - n of x, lanes below n come from
+        // dest
+        inline static Vector slide_up(auto dest, auto x, size_t n, size_t size)
+        {
+            return __riscv_vslideup(dest, x, n, size);
+        }
+
+        // lane i of the result is lane i + n of x, 0 past the last lane
+        inline static Vector slide_down(auto x, size_t n, size_t size)
+        {
+            return __riscv_vslidedown(x, n, size);
+        }
+
+        inline static Vector compress(auto x, auto mask, size_t size)
+        {
+            return __riscv_vcompress(x, mask, size);
+        }
+
         // Reduction Operations
 
         inline static T reduce_sum(auto x, size_t size)
@@ -224,6 +520,47 @@ namespace rvv_impl {
             return __riscv_vmul(x, y, size);
         }
 
+        inline static Vector multiply_high(auto x, auto y, size_t size)
+        {
+            return __riscv_vmulhu(x, y, size);
+        }
+
+        inline static Vector fma(auto x, auto y, auto z, size_t size)
+        {
+            return __riscv_vmadd(x, y, z, size);
+        }
+
+        inline static Vector shift_left(auto x, size_t n, size_t size)
+        {
+            return __riscv_vsll(x, n, size);
+        }
+
+        inline static Vector shift_right(auto x, size_t n, size_t size)
+        {
+            return __riscv_vsrl(x, n, size);
+        }
+
+        // Carry chains, carries and borrows are masks
+
+        inline static Vector add_carry(auto x, auto y, auto carry, size_t size)
+        {
+            return __riscv_vadc(x, y, carry, size);
+        }
+
+        inline static auto carry_out(auto x, auto y, auto carry, size_t size)
+        {
+            return __riscv_vmadc(x, y, carry, size);
+        }
+
+        inline static Vector sub_borrow(auto x, auto y, auto borrow, size_t size)
+        {
+            return __riscv_vsbc(x, y, borrow, size);
+        }
+
+        inline static auto borrow_out(auto x, auto y, auto borrow, size_t size)
+        {
+            return __riscv_vmsbc(x, y, borrow, size);
+        }
         
         inline static Vector min(auto x, auto y, size_t size)
         {
@@ -234,6 +571,30 @@ namespace rvv_impl {
         {
             return __riscv_vmaxu(x, y, size);
         }
+
+        // lane i of the result is lane idx[i] of x
+        inline static Vector gather(auto x, auto idx, size_t size)
+        {
+            return __riscv_vrgather(x, idx, size);
+        }
+
+        // lane i of the result is lane i - n of x, lanes below n come from
+        // dest
+        inline static Vector slide_up(auto dest, auto x, size_t n, size_t size)
+        {
+            return __riscv_vslideup(dest, x, n, size);
+        }
+
+        // lane i of the result is lane i + n of x, 0 past the last lane
+        inline static Vector slide_down(auto x, size_t n, size_t size)
+        {
+            return __riscv_vslidedown(x, n, size);
+        }
+
+        inline static Vector compress(auto x, auto mask, size_t size)
+        {
+            return __riscv_vcompress(x, mask, size);
+        }
         
         // Reduction Operations
         inline static T reduce_sum(auto x, size_t size)
@@ -312,6 +673,24 @@ namespace rvv_impl {
             return __riscv_vfmul(x, y, size);
         }
 
+        inline static Vector fma(auto x, auto y, auto z, size_t size)
+        {
+            return __riscv_vfmadd(x, y, z, size);
+        }
+
+        // Classification, classes is a combination of vfclass result bits
+
+        inline static auto fclass(auto x, size_t size)
+        {
+            return __riscv_vfclass(x, size);
+        }
+
+        inline static auto classify(auto x, unsigned classes, size_t size)
+        {
+            return __riscv_vmsne(
+                __riscv_vand(fclass(x, size), classes, size), 0, size);
+        }
+
         inline static Vector min(auto x, auto y, size_t size)
         {
             return __riscv_vfmin(x, y, size);
@@ -322,6 +701,30 @@ namespace rvv_impl {
             return __riscv_vfmax(x, y, size);
         }
 
+        // lane i of the result is lane idx[i] of x
+        inline static Vector gather(auto x, auto idx, size_t size)
+        {
+            return __riscv_vrgather(x, idx, size);
+        }
+
+        // lane i of the result is lane i - n of x, lanes below n come from
+        // dest
+        inline static Vector slide_up(auto dest, auto x, size_t n, size_t size)
+        {
+            return __riscv_vslideup(dest, x, n, size);
+        }
+
+        // lane i of the result is lane i + n of x, 0 past the last lane
+        inline static Vector slide_down(auto x, size_t n, size_t size)
+        {
+            return __riscv_vslidedown(x, n, size);
+        }
+
+        inline static Vector compress(auto x, auto mask, size_t size)
+        {
+            return __riscv_vcompress(x, mask, size);
+        }
+
         // Reduction Operations
 
         inline static T reduce_sum(auto x, size_t size)
@@ -486,9 +889,42 @@ namespace rvv_impl {
         static constexpr std::size_t size = max_vector_pack_size / sizeof(value_t);
 
         template <typename T>
-        inline static Vector load(const T* ptr)
+        inline static Vector load(const T* ptr, std::size_t n = size)
+        {
+            return __riscv_vle8_v_i8m1(ptr, n);
+        }
+
+        // lane i of the result is ptr[idx[i]]
+        template <typename T>
+        inline static Vector load_indexed(
+            const T* ptr, auto idx, std::size_t n = size)
+        {
+            return __riscv_vluxei8_v_i8m1(
+                ptr, __riscv_vsll(idx, 0, n), n);
+        }
+
+        // ptr[idx[i]] is lane i of vec, lanes with the same index store in
+        // an unspecified order
+        template <typename T>
+        inline static void store_indexed(
+            Vector vec, T* ptr, auto idx, std::size_t n = size)
+        {
+            __riscv_vsuxei8(ptr, __riscv_vsll(idx, 0, n), vec, n);
+        }
+
+        // ptr[0], ptr[stride], ptr[2 * stride], ... with stride in elements
+        template <typename T>
+        inline static Vector load_strided(
+            const T* ptr, std::ptrdiff_t stride, std::size_t n = size)
+        {
+            return __riscv_vlse8_v_i8m1(ptr, stride * sizeof(T), n);
+        }
+
+        template <typename T>
+        inline static void store_strided(
+            Vector vec, T* ptr, std::ptrdiff_t stride, std::size_t n = size)
         {
-            return __riscv_vle8_v_i8m1(ptr, size);
+            __riscv_vsse8(ptr, stride * sizeof(T), vec, n);
         }
 
         inline static const value_t iota_array[64] = {
@@ -496,12 +932,12 @@ namespace rvv_impl {
             16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31,
             32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47,
             48, 49, 50, 51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 62, 63};
-        inline static const Vector index0123 = load(iota_array);
+        inline static const Vector index0123 = load(iota_array, size);
 
         template <typename T>
-        inline static void store(Vector vec, T* ptr)
+        inline static void store(Vector vec, T* ptr, std::size_t n = size)
         {
-            __riscv_vse8(ptr, vec, size);
+            __riscv_vse8(ptr, vec, n);
         }
 
         inline static Vector set(Vector vec, size_t index, value_t val)
@@ -552,9 +988,42 @@ namespace rvv_impl {
         // inline static const Vector index0123 = index_series(value_t(0), value_t(1));
 
         template <typename T>
-        inline static Vector load(const T* ptr)
+        inline static Vector load(const T* ptr, std::size_t n = size)
+        {
+            return __riscv_vle8_v_u8m1(ptr, n);
+        }
+
+        // lane i of the result is ptr[idx[i]]
+        template <typename T>
+        inline static Vector load_indexed(
+            const T* ptr, auto idx, std::size_t n = size)
+        {
+            return __riscv_vluxei8_v_u8m1(
+                ptr, __riscv_vsll(idx, 0, n), n);
+        }
+
+        // ptr[idx[i]] is lane i of vec, lanes with the same index store in
+        // an unspecified order
+        template <typename T>
+        inline static void store_indexed(
+            Vector vec, T* ptr, auto idx, std::size_t n = size)
+        {
+            __riscv_vsuxei8(ptr, __riscv_vsll(idx, 0, n), vec, n);
+        }
+
+        // ptr[0], ptr[stride], ptr[2 * stride], ... with stride in elements
+        template <typename T>
+        inline static Vector load_strided(
+            const T* ptr, std::ptrdiff_t stride, std::size_t n = size)
+        {
+            return __riscv_vlse8_v_u8m1(ptr, stride * sizeof(T), n);
+        }
+
+        template <typename T>
+        inline static void store_strided(
+            Vector vec, T* ptr, std::ptrdiff_t stride, std::size_t n = size)
         {
-            return __riscv_vle8_v_u8m1(ptr, size);
+            __riscv_vsse8(ptr, stride * sizeof(T), vec, n);
         }
 
         inline static const value_t iota_array[64] = {
@@ -562,12 +1031,12 @@ namespace rvv_impl {
             16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31,
             32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47,
             48, 49, 50, 51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 62, 63};
-        inline static const Vector index0123 = load(iota_array);
+        inline static const Vector index0123 = load(iota_array, size);
 
         template <typename T>
-        inline static void store(Vector vec, T* ptr)
+        inline static void store(Vector vec, T* ptr, std::size_t n = size)
         {
-            __riscv_vse8(ptr, vec, size);
+            __riscv_vse8(ptr, vec, n);
         }
 
         inline static Vector set(Vector vec, size_t index, value_t val)
@@ -592,20 +1061,53 @@ namespace rvv_impl {
         static constexpr std::size_t size = max_vector_pack_size / sizeof(value_t);
 
         template <typename T>
-        inline static Vector load(const T* ptr)
+        inline static Vector load(const T* ptr, std::size_t n = size)
+        {
+            return __riscv_vle16_v_i16m1(ptr, n);
+        }
+
+        // lane i of the result is ptr[idx[i]]
+        template <typename T>
+        inline static Vector load_indexed(
+            const T* ptr, auto idx, std::size_t n = size)
+        {
+            return __riscv_vluxei16_v_i16m1(
+                ptr, __riscv_vsll(idx, 1, n), n);
+        }
+
+        // ptr[idx[i]] is lane i of vec, lanes with the same index store in
+        // an unspecified order
+        template <typename T>
+        inline static void store_indexed(
+            Vector vec, T* ptr, auto idx, std::size_t n = size)
+        {
+            __riscv_vsuxei16(ptr, __riscv_vsll(idx, 1, n), vec, n);
+        }
+
+        // ptr[0], ptr[stride], ptr[2 * stride], ... with stride in elements
+        template <typename T>
+        inline static Vector load_strided(
+            const T* ptr, std::ptrdiff_t stride, std::size_t n = size)
+        {
+            return __riscv_vlse16_v_i16m1(ptr, stride * sizeof(T), n);
+        }
+
+        template <typename T>
+        inline static void store_strided(
+            Vector vec, T* ptr, std::ptrdiff_t stride, std::size_t n = size)
         {
-            return __riscv_vle16_v_i16m1(ptr, size);
+            __riscv_vsse16(ptr, stride * sizeof(T), vec, n);
         }
 
         inline static const value_t iota_array[32] = {
             0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
             16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31};
-        inline static const Vector index0123 = load(iota_array);
+        inline static const Vector index0123 = load(iota_array, size);
 
         template <typename T>
-        inline static void store(Vector vec, T* ptr)
+        inline static void store(Vector vec, T* ptr, std::size_t n = size)
         {
-            __riscv_vse16(ptr, vec, size);
+            __riscv_vse16(ptr, vec, n);
         }
 
         inline static Vector set(Vector vec, size_t index, value_t val)
@@ -638,20 +1140,53 @@ namespace rvv_impl {
         static constexpr std::size_t size = max_vector_pack_size / sizeof(value_t);
 
         template <typename T>
-        inline static Vector load(const T* ptr)
+        inline static Vector load(const T* ptr, std::size_t n = size)
+        {
+            return __riscv_vle16_v_u16m1(ptr, n);
+        }
+
+        // lane i of the result is ptr[idx[i]]
+        template <typename T>
+        inline static Vector load_indexed(
+            const T* ptr, auto idx, std::size_t n = size)
+        {
+            return __riscv_vluxei16_v_u16m1(
+                ptr, __riscv_vsll(idx, 1, n), n);
+        }
+
+        // ptr[idx[i]] is lane i of vec, lanes with the same index store in
+        // an unspecified order
+        template <typename T>
+        inline static void store_indexed(
+            Vector vec, T* ptr, auto idx, std::size_t n = size)
+        {
+            __riscv_vsuxei16(ptr, __riscv_vsll(idx, 1, n), vec, n);
+        }
+
+        // ptr[0], ptr[stride], ptr[2 * stride], ... with stride in elements
+        template <typename T>
+        inline static Vector load_strided(
+            const T* ptr, std::ptrdiff_t stride, std::size_t n = size)
+        {
+            return __riscv_vlse16_v_u16m1(ptr, stride * sizeof(T), n);
+        }
+
+        template <typename T>
+        inline static void store_strided(
+            Vector vec, T* ptr, std::ptrdiff_t stride, std::size_t n = size)
         {
-            return __riscv_vle16_v_u16m1(ptr, size);
+            __riscv_vsse16(ptr, stride * sizeof(T), vec, n);
         }
 
         inline static const value_t iota_array[32] = {
             0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
             16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31};
-        inline static const Vector index0123 = load(iota_array);
+        inline static const Vector index0123 = load(iota_array, size);
 
         template <typename T>
-        inline static void store(Vector vec, T* ptr)
+        inline static void store(Vector vec, T* ptr, std::size_t n = size)
         {
-            __riscv_vse16(ptr, vec, size);
+            __riscv_vse16(ptr, vec, n);
         }
 
         inline static Vector set(Vector vec, size_t index, value_t val)
@@ -683,19 +1218,52 @@ namespace rvv_impl {
         static constexpr std::size_t size = max_vector_pack_size / sizeof(value_t);
 
         template <typename T>
-        inline static Vector load(const T* ptr)
+        inline static Vector load(const T* ptr, std::size_t n = size)
+        {
+            return __riscv_vle32_v_i32m1(ptr, n);
+        }
+
+        // lane i of the result is ptr[idx[i]]
+        template <typename T>
+        inline static Vector load_indexed(
+            const T* ptr, auto idx, std::size_t n = size)
+        {
+            return __riscv_vluxei32_v_i32m1(
+                ptr, __riscv_vsll(idx, 2, n), n);
+        }
+
+        // ptr[idx[i]] is lane i of vec, lanes with the same index store in
+        // an unspecified order
+        template <typename T>
+        inline static void store_indexed(
+            Vector vec, T* ptr, auto idx, std::size_t n = size)
+        {
+            __riscv_vsuxei32(ptr, __riscv_vsll(idx, 2, n), vec, n);
+        }
+
+        // ptr[0], ptr[stride], ptr[2 * stride], ... with stride in elements
+        template <typename T>
+        inline static Vector load_strided(
+            const T* ptr, std::ptrdiff_t stride, std::size_t n = size)
+        {
+            return __riscv_vlse32_v_i32m1(ptr, stride * sizeof(T), n);
+        }
+
+        template <typename T>
+        inline static void store_strided(
+            Vector vec, T* ptr, std::ptrdiff_t stride, std::size_t n = size)
         {
-            return __riscv_vle32_v_i32m1(ptr, size);
+            __riscv_vsse32(ptr, stride * sizeof(T), vec, n);
         }
 
         inline static const value_t iota_array[16] = {
             0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
-        inline static const Vector index0123 = load(iota_array);
+        inline static const Vector index0123 = load(iota_array, size);
 
         template <typename T>
-        inline static void store(Vector vec, T* ptr)
+        inline static void store(Vector vec, T* ptr, std::size_t n = size)
         {
-            __riscv_vse32(ptr, vec, size);
+            __riscv_vse32(ptr, vec, n);
         }
 
         inline static Vector set(Vector vec, size_t index, value_t val)
@@ -719,19 +1287,52 @@ namespace rvv_impl {
         static constexpr std::size_t size = max_vector_pack_size / sizeof(value_t);
 
         template <typename T>
-        inline static Vector load(const T* ptr)
+        inline static Vector load(const T* ptr, std::size_t n = size)
+        {
+            return __riscv_vle32_v_u32m1(ptr, n);
+        }
+
+        // lane i of the result is ptr[idx[i]]
+        template <typename T>
+        inline static Vector load_indexed(
+            const T* ptr, auto idx, std::size_t n = size)
+        {
+            return __riscv_vluxei32_v_u32m1(
+                ptr, __riscv_vsll(idx, 2, n), n);
+        }
+
+        // ptr[idx[i]] is lane i of vec, lanes with the same index store in
+        // an unspecified order
+        template <typename T>
+        inline static void store_indexed(
+            Vector vec, T* ptr, auto idx, std::size_t n = size)
+        {
+            __riscv_vsuxei32(ptr, __riscv_vsll(idx, 2, n), vec, n);
+        }
+
+        // ptr[0], ptr[stride], ptr[2 * stride], ... with stride in elements
+        template <typename T>
+        inline static Vector load_strided(
+            const T* ptr, std::ptrdiff_t stride, std::size_t n = size)
+        {
+            return __riscv_vlse32_v_u32m1(ptr, stride * sizeof(T), n);
+        }
+
+        template <typename T>
+        inline static void store_strided(
+            Vector vec, T* ptr, std::ptrdiff_t stride, std::size_t n = size)
         {
-            return __riscv_vle32_v_u32m1(ptr, size);
+            __riscv_vsse32(ptr, stride * sizeof(T), vec, n);
         }
 
         inline static const value_t iota_array[16] = {
             0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
-        inline static const Vector index0123 = load(iota_array);
+        inline static const Vector index0123 = load(iota_array, size);
 
         template <typename T>
-        inline static void store(Vector vec, T* ptr)
+        inline static void store(Vector vec, T* ptr, std::size_t n = size)
         {
-            __riscv_vse32(ptr, vec, size);
+            __riscv_vse32(ptr, vec, n);
         }
 
         inline static Vector set(Vector vec, size_t index, value_t val)
@@ -755,19 +1356,52 @@ template <>
         static constexpr std::size_t size = max_vector_pack_size / sizeof(value_t);
 
         template <typename T>
-        inline static Vector load(const T* ptr)
+        inline static Vector load(const T* ptr, std::size_t n = size)
+        {
+            return __riscv_vle64_v_i64m1(ptr, n);
+        }
+
+        // lane i of the result is ptr[idx[i]]
+        template <typename T>
+        inline static Vector load_indexed(
+            const T* ptr, auto idx, std::size_t n = size)
+        {
+            return __riscv_vluxei64_v_i64m1(
+                ptr, __riscv_vsll(idx, 3, n), n);
+        }
+
+        // ptr[idx[i]] is lane i of vec, lanes with the same index store in
+        // an unspecified order
+        template <typename T>
+        inline static void store_indexed(
+            Vector vec, T* ptr, auto idx, std::size_t n = size)
+        {
+            __riscv_vsuxei64(ptr, __riscv_vsll(idx, 3, n), vec, n);
+        }
+
+        // ptr[0], ptr[stride], ptr[2 * stride], ... with stride in elements
+        template <typename T>
+        inline static Vector load_strided(
+            const T* ptr, std::ptrdiff_t stride, std::size_t n = size)
+        {
+            return __riscv_vlse64_v_i64m1(ptr, stride * sizeof(T), n);
+        }
+
+        template <typename T>
+        inline static void store_strided(
+            Vector vec, T* ptr, std::ptrdiff_t stride, std::size_t n = size)
         {
-            return __riscv_vle64_v_i64m1(ptr, size);
+            __riscv_vsse64(ptr, stride * sizeof(T), vec, n);
         }
 
         inline static const value_t iota_array[8] = {
             0, 1, 2, 3, 4, 5, 6, 7};
-        inline static const Vector index0123 = load(iota_array);
+        inline static const Vector index0123 = load(iota_array, size);
 
         template <typename T>
-        inline static void store(Vector vec, T* ptr)
+        inline static void store(Vector vec, T* ptr, std::size_t n = size)
         {
-            __riscv_vse64(ptr, vec, size);
+            __riscv_vse64(ptr, vec, n);
         }
 
         inline static Vector set(Vector vec, size_t index, value_t val)
@@ -791,19 +1425,52 @@ template <>
         static constexpr std::size_t size = max_vector_pack_size / sizeof(value_t);
 
         template <typename T>
-        inline static Vector load(const T* ptr)
+        inline static Vector load(const T* ptr, std::size_t n = size)
         {
-            return __riscv_vle64_v_u64m1(ptr, size);
+            return __riscv_vle64_v_u64m1(ptr, n);
         }
 
-        inline static const value_t iota_array[8] = {
-            0, 1, 2, 3, 4, 5, 6, 7};
-        inline static const Vector index0123 = load(iota_array);
-
+        // lane i of the result is ptr[idx[i]]
         template <typename T>
-        inline static void store(Vector vec, T* ptr)
+        inline static Vector load_indexed(
+            const T* ptr, auto idx, std::size_t n = size)
         {
-            __riscv_vse64(ptr, vec, size);
+            return __riscv_vluxei64_v_u64m1(
+                ptr, __riscv_vsll(idx, 3, n), n);
+        }
+
+        // ptr[idx[i]] is lane i of vec, lanes with the same index store in
+        // an unspecified order
+        template <typename T>
+        inline static void store_indexed(
+            Vector vec, T* ptr, auto idx, std::size_t n = size)
+        {
+            __riscv_vsuxei64(ptr, __riscv_vsll(idx, 3, n), vec, n);
+        }
+
+        // ptr[0], ptr[stride], ptr[2 * stride], ... with stride in elements
+        template <typename T>
+        inline static Vector load_strided(
+            const T* ptr, std::ptrdiff_t stride, std::size_t n = size)
+        {
+            return __riscv_vlse64_v_u64m1(ptr, stride * sizeof(T), n);
+        }
+
+        template <typename T>
+        inline static void store_strided(
+            Vector vec, T* ptr, std::ptrdiff_t stride, std::size_t n = size)
+        {
+            __riscv_vsse64(ptr, stride * sizeof(T), vec, n);
+        }
+
+        inline static const value_t iota_array[8] = {
+            0, 1, 2, 3, 4, 5, 6, 7};
+        inline static const Vector index0123 = load(iota_array, size);
+
+        template <typename T>
+        inline static void store(Vector vec, T* ptr, std::size_t n = size)
+        {
+            __riscv_vse64(ptr, vec, n);
         }
 
         inline static Vector set(Vector vec, size_t index, value_t val)
@@ -852,19 +1519,52 @@ template <>
         static constexpr std::size_t size = max_vector_pack_size / sizeof(value_t);
 
         template <typename T>
-        inline static Vector load(const T* ptr)
+        inline static Vector load(const T* ptr, std::size_t n = size)
+        {
+            return __riscv_vle32_v_f32m1(ptr, n);
+        }
+
+        // lane i of the result is ptr[idx[i]]
+        template <typename T>
+        inline static Vector load_indexed(
+            const T* ptr, auto idx, std::size_t n = size)
         {
-            return __riscv_vle32_v_f32m1(ptr, size);
+            return __riscv_vluxei32_v_f32m1(
+                ptr, __riscv_vsll(idx, 2, n), n);
+        }
+
+        // ptr[idx[i]] is lane i of vec, lanes with the same index store in
+        // an unspecified order
+        template <typename T>
+        inline static void store_indexed(
+            Vector vec, T* ptr, auto idx, std::size_t n = size)
+        {
+            __riscv_vsuxei32(ptr, __riscv_vsll(idx, 2, n), vec, n);
+        }
+
+        // ptr[0], ptr[stride], ptr[2 * stride], ... with stride in elements
+        template <typename T>
+        inline static Vector load_strided(
+            const T* ptr, std::ptrdiff_t stride, std::size_t n = size)
+        {
+            return __riscv_vlse32_v_f32m1(ptr, stride * sizeof(T), n);
+        }
+
+        template <typename T>
+        inline static void store_strided(
+            Vector vec, T* ptr, std::ptrdiff_t stride, std::size_t n = size)
+        {
+            __riscv_vsse32(ptr, stride * sizeof(T), vec, n);
         }
 
         inline static const value_t iota_array[16] = {
             0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
-        inline static const Vector index0123 = load(iota_array);
+        inline static const Vector index0123 = load(iota_array, size);
 
         template <typename T>
-        inline static void store(Vector vec, T* ptr)
+        inline static void store(Vector vec, T* ptr, std::size_t n = size)
         {
-            __riscv_vse32(ptr, vec, size);
+            __riscv_vse32(ptr, vec, n);
         }
 
 
@@ -891,19 +1591,52 @@ template <>
         static constexpr std::size_t size = max_vector_pack_size / sizeof(value_t);
 
         template <typename T>
-        inline static Vector load(const T* ptr)
+        inline static Vector load(const T* ptr, std::size_t n = size)
+        {
+            return __riscv_vle64_v_f64m1(ptr, n);
+        }
+
+        // lane i of the result is ptr[idx[i]]
+        template <typename T>
+        inline static Vector load_indexed(
+            const T* ptr, auto idx, std::size_t n = size)
+        {
+            return __riscv_vluxei64_v_f64m1(
+                ptr, __riscv_vsll(idx, 3, n), n);
+        }
+
+        // ptr[idx[i]] is lane i of vec, lanes with the same index store in
+        // an unspecified order
+        template <typename T>
+        inline static void store_indexed(
+            Vector vec, T* ptr, auto idx, std::size_t n = size)
+        {
+            __riscv_vsuxei64(ptr, __riscv_vsll(idx, 3, n), vec, n);
+        }
+
+        // ptr[0], ptr[stride], ptr[2 * stride], ... with stride in elements
+        template <typename T>
+        inline static Vector load_strided(
+            const T* ptr, std::ptrdiff_t stride, std::size_t n = size)
         {
-            return __riscv_vle64_v_f64m1(ptr, size);
+            return __riscv_vlse64_v_f64m1(ptr, stride * sizeof(T), n);
+        }
+
+        template <typename T>
+        inline static void store_strided(
+            Vector vec, T* ptr, std::ptrdiff_t stride, std::size_t n = size)
+        {
+            __riscv_vsse64(ptr, stride * sizeof(T), vec, n);
         }
 
         inline static const value_t iota_array[8] = {
             0, 1, 2, 3, 4, 5, 6, 7};
-        inline static const Vector index0123 = load(iota_array);
+        inline static const Vector index0123 = load(iota_array, size);
 
         template <typename T>
-        inline static void store(Vector vec, T* ptr)
+        inline static void store(Vector vec, T* ptr, std::size_t n = size)
         {
-            __riscv_vse64(ptr, vec, size);
+            __riscv_vse64(ptr, vec, n);
         }
 
 
@@ -970,6 +1703,40 @@ namespace rvv::experimental { inline namespace parallelism_v2 {
     template <size_t N>
     inline constexpr overaligned_tag<N> overaligned{};
 
+    // rounding modes for floating to integral conversion, dynamic uses the
+    // mode currently set in the frm register
+    enum class rounding_mode : unsigned
+    {
+        nearest_even = __RISCV_FRM_RNE,
+        toward_zero = __RISCV_FRM_RTZ,
+        downward = __RISCV_FRM_RDN,
+        upward = __RISCV_FRM_RUP,
+        nearest_away = __RISCV_FRM_RMM,
+        dynamic = __RISCV_FRM_RMM + 1
+    };
+
+    // floating point classes as reported by vfclass, combine them to test
+    // for several classes at once with is_fp_class
+    namespace fp_class {
+        inline constexpr unsigned negative_infinity = 1u << 0;
+        inline constexpr unsigned negative_normal = 1u << 1;
+        inline constexpr unsigned negative_subnormal = 1u << 2;
+        inline constexpr unsigned negative_zero = 1u << 3;
+        inline constexpr unsigned positive_zero = 1u << 4;
+        inline constexpr unsigned positive_subnormal = 1u << 5;
+        inline constexpr unsigned positive_normal = 1u << 6;
+        inline constexpr unsigned positive_infinity = 1u << 7;
+        inline constexpr unsigned signaling_nan = 1u << 8;
+        inline constexpr unsigned quiet_nan = 1u << 9;
+
+        inline constexpr unsigned infinity = negative_infinity | positive_infinity;
+        inline constexpr unsigned normal = negative_normal | positive_normal;
+        inline constexpr unsigned subnormal = negative_subnormal | positive_subnormal;
+        inline constexpr unsigned zero = negative_zero | positive_zero;
+        inline constexpr unsigned nan = signaling_nan | quiet_nan;
+        inline constexpr unsigned finite = normal | subnormal | zero;
+    }    // namespace fp_class
+
     // ----------------------------------------------------------------------
     // traits [simd.traits]
     // ----------------------------------------------------------------------
@@ -1140,6 +1907,44 @@ namespace rvv::experimental { inline namespace parallelism_v2 {
             // svst1(all_true, ptr, vec);
         }
 
+        // Load and store of the first n elements for the tail of a range,
+        // the remaining elements of a partial load are unspecified
+        template <typename U>
+        inline void partial_copy_from(const U* ptr, std::size_t n)
+        {
+            static_assert(std::is_same_v<std::remove_cvref_t<U>, T>,
+                "pointer should be same type as value_type");
+            vec = Impl::load(ptr, n);
+        }
+
+        template <typename U>
+        inline void partial_copy_to(U* ptr, std::size_t n) const
+        {
+            static_assert(std::is_same_v<std::remove_cvref_t<U>, T>,
+                "pointer should be same type as value_type");
+            Impl::store(vec, ptr, n);
+        }
+
+        // Load and store of the first n elements at ptr[0], ptr[stride],
+        // ptr[2 * stride], ... with the stride counted in elements
+        template <typename U>
+        inline void strided_copy_from(
+            const U* ptr, std::ptrdiff_t stride, std::size_t n = size())
+        {
+            static_assert(std::is_same_v<std::remove_cvref_t<U>, T>,
+                "pointer should be same type as value_type");
+            vec = Impl::load_strided(ptr, stride, n);
+        }
+
+        template <typename U>
+        inline void strided_copy_to(
+            U* ptr, std::ptrdiff_t stride, std::size_t n = size()) const
+        {
+            static_assert(std::is_same_v<std::remove_cvref_t<U>, T>,
+                "pointer should be same type as value_type");
+            Impl::store_strided(vec, ptr, stride, n);
+        }
+
         // ----------------------------------------------------------------------
         //  get and set
         // ----------------------------------------------------------------------
@@ -1300,20 +2105,23 @@ namespace rvv::experimental { inline namespace parallelism_v2 {
         {
             static_assert(std::is_integral_v<T>,
                 "operator^ only works for integeral types");
-            return __riscv_xor(x.vec, y.vec, Impl::size);
+            return __riscv_vxor(x.vec, y.vec, Impl::size);
         }
 
-//         // friend simd operator<<(const simd& x, typename std::make_unsigned<T>::type
-//         // n)
-//         // {
-//         //     return left_shift(x.vec, n);
-//         // }
+        inline friend simd operator<<(const simd& x, int n)
+        {
+            static_assert(std::is_integral_v<T>,
+                "operator<< only works for integeral types");
+            return Impl::shift_left(x.vec, n, Impl::size);
+        }
 
-//         // friend std::enable_if_t<std::is_unsigned_v<T>, simd>
-//         // friend simd operator>>(const simd& x, T n)
-//         // {
-//         //     return right_shift(x.vec, n);
-//         // }
+        // arithmetic shift for signed types, logical shift for unsigned types
+        inline friend simd operator>>(const simd& x, int n)
+        {
+            static_assert(std::is_integral_v<T>,
+                "operator>> only works for integeral types");
+            return Impl::shift_right(x.vec, n, Impl::size);
+        }
 
         // ----------------------------------------------------------------------
         // compound assignment [simd.cassign]
@@ -1366,17 +2174,21 @@ namespace rvv::experimental { inline namespace parallelism_v2 {
             return x;
         }
 
-//         // friend simd operator<<=(simd& x, typename std::make_unsigned<T>::type n)
-//         // {
-//         //     x.vec = left_shift(x.vec, n);
-//         //     return x;
-//         // }
+        inline friend simd& operator<<=(simd& x, int n)
+        {
+            static_assert(std::is_integral_v<T>,
+                "operator<<= only works for integeral types");
+            x.vec = Impl::shift_left(x.vec, n, Impl::size);
+            return x;
+        }
 
-//         // friend simd operator>>=(simd& x, T n)
-//         // {
-//         //     x.vec = right_shift(x.vec, n);
-//         //     return x;
-//         // }
+        inline friend simd& operator>>=(simd& x, int n)
+        {
+            static_assert(std::is_integral_v<T>,
+                "operator>>= only works for integeral types");
+            x.vec = Impl::shift_right(x.vec, n, Impl::size);
+            return x;
+        }
 
         // ----------------------------------------------------------------------
         // compares [simd.comparison]
@@ -1421,6 +2233,16 @@ namespace rvv::experimental { inline namespace parallelism_v2 {
         inline friend void mask_assign(const simd_mask<T_, Abi_>& msk,
             simd<T_, Abi_>& v, const simd<T_, Abi_>& val);
 
+        template <typename T_, typename Abi_>
+        inline friend simd<T_, Abi_> add_with_carry(const simd<T_, Abi_>& x,
+            const simd<T_, Abi_>& y, const simd_mask<T_, Abi_>& carry_in,
+            simd_mask<T_, Abi_>& carry_out);
+
+        template <typename T_, typename Abi_>
+        inline friend simd<T_, Abi_> sub_with_borrow(const simd<T_, Abi_>& x,
+            const simd<T_, Abi_>& y, const simd_mask<T_, Abi_>& borrow_in,
+            simd_mask<T_, Abi_>& borrow_out);
+
         template <typename T_, typename Abi_>
         inline friend simd<T_, Abi_> min(
             const simd<T_, Abi_>& x, const simd<T_, Abi_>& y);
@@ -1435,12 +2257,98 @@ namespace rvv::experimental { inline namespace parallelism_v2 {
         template <typename T_, typename Abi_>
         inline friend simd<T_, Abi_> sqrt(const simd<T_, Abi_>& x);
 
+        template <typename T_, typename Abi_>
+        inline friend simd<T_, Abi_> reciprocal_estimate(const simd<T_, Abi_>& x);
+
+        template <typename T_, typename Abi_>
+        inline friend simd<T_, Abi_> rsqrt_estimate(const simd<T_, Abi_>& x);
+
         template <typename T_, typename Abi_>
         inline friend simd<T_, Abi_> abs(const simd<T_, Abi_>& x);
 
-//         template <typename T_, typename Abi_>
-//         inline friend simd<T_, Abi_> fma(const simd<T_, Abi_>& a,
-//             const simd<T_, Abi_>& b, const simd<T_, Abi_>& z);
+        template <typename T_, typename Abi_>
+        inline friend simd<T_, Abi_> fma(const simd<T_, Abi_>& a,
+            const simd<T_, Abi_>& b, const simd<T_, Abi_>& z);
+
+        template <typename U_, typename T_, typename Abi_>
+        inline friend simd<U_, Abi_> static_simd_cast(const simd<T_, Abi_>& x);
+
+        template <typename U_, typename T_, typename Abi_>
+        inline friend simd<U_, Abi_> simd_bit_cast(const simd<T_, Abi_>& x);
+
+        template <rounding_mode R, typename T_, typename Abi_>
+        inline friend simd<rvv_impl::integral_of<T_>, Abi_> to_int(
+            const simd<T_, Abi_>& x);
+
+        template <unsigned Classes, typename T_, typename Abi_>
+        inline friend simd_mask<T_, Abi_> is_fp_class(const simd<T_, Abi_>& x);
+
+        template <typename T_, typename Abi_>
+        inline friend simd<rvv_impl::integral_of<T_>, Abi_> fpclassify(
+            const simd<T_, Abi_>& x);
+
+        template <typename T_, typename Abi_>
+        inline friend simd<T_, Abi_> popcount(const simd<T_, Abi_>& x);
+
+        template <typename T_, typename Abi_>
+        inline friend simd<T_, Abi_> countl_zero(const simd<T_, Abi_>& x);
+
+        template <typename T_, typename Abi_>
+        inline friend simd<T_, Abi_> countr_zero(const simd<T_, Abi_>& x);
+
+        template <typename T_, typename Abi_>
+        inline friend simd<T_, Abi_> byteswap(const simd<T_, Abi_>& x);
+
+        template <typename T_, typename Abi_>
+        inline friend simd<T_, Abi_> bit_reverse(const simd<T_, Abi_>& x);
+
+        template <typename T_, typename Abi_>
+        inline friend simd<T_, Abi_> andn(
+            const simd<T_, Abi_>& x, const simd<T_, Abi_>& y);
+
+        template <typename T_, typename Abi_>
+        inline friend simd<T_, Abi_> clmul(
+            const simd<T_, Abi_>& x, const simd<T_, Abi_>& y);
+
+        template <typename T_, typename Abi_>
+        inline friend simd<T_, Abi_> clmulh(
+            const simd<T_, Abi_>& x, const simd<T_, Abi_>& y);
+
+        template <typename T_, typename Abi_>
+        inline friend simd<T_, Abi_> mulhi(
+            const simd<T_, Abi_>& x, const simd<T_, Abi_>& y);
+
+        template <typename T_, typename Abi_>
+        inline friend simd<T_, Abi_> mulhsu(const simd<T_, Abi_>& x,
+            const simd<std::make_unsigned_t<T_>, Abi_>& y);
+
+        template <typename T_, typename Abi_>
+        inline friend simd<T_, Abi_> permute(const simd<T_, Abi_>& x,
+            const simd<rvv_impl::index_of<T_>, Abi_>& idx);
+
+        template <typename T_, typename Abi_>
+        inline friend simd<T_, Abi_> slide_up(
+            const simd<T_, Abi_>& x, std::size_t n);
+
+        template <typename T_, typename Abi_>
+        inline friend simd<T_, Abi_> slide_down(
+            const simd<T_, Abi_>& x, std::size_t n);
+
+        template <typename T_, typename Abi_>
+        inline friend simd<T_, Abi_> gather(
+            const T_* ptr, const simd<rvv_impl::index_of<T_>, Abi_>& idx);
+
+        template <typename T_, typename Abi_>
+        inline friend simd<T_, Abi_> gather(const T_* ptr,
+            const simd<rvv_impl::index_of<T_>, Abi_>& idx, std::size_t n);
+
+        template <typename T_, typename Abi_>
+        inline friend void scatter(const simd<T_, Abi_>& x, T_* ptr,
+            const simd<rvv_impl::index_of<T_>, Abi_>& idx);
+
+        template <typename T_, typename Abi_>
+        inline friend void scatter(const simd<T_, Abi_>& x, T_* ptr,
+            const simd<rvv_impl::index_of<T_>, Abi_>& idx, std::size_t n);
 
         template <typename T_, typename Abi_, typename Op>
         inline friend T_ reduce(const simd<T_, Abi_>& x, Op op);
@@ -1456,9 +2364,9 @@ namespace rvv::experimental { inline namespace parallelism_v2 {
 //         template <typename T_, typename Abi_>
 //         inline friend simd<T_, Abi_> index_series(T_ base, T_ step);
 
-//         template <typename T_, typename Abi_>
-//         inline friend simd<T_, Abi_> compact(
-//             const simd_mask<T_, Abi_>& msk, const simd<T_, Abi_>& v);
+        template <typename T_, typename Abi_>
+        inline friend simd<T_, Abi_> compact(
+            const simd_mask<T_, Abi_>& msk, const simd<T_, Abi_>& v);
 
 //         template <typename T_, typename Abi_>
 //         inline friend simd<T_, Abi_> splice(const simd_mask<T_, Abi_>& msk,
@@ -1511,6 +2419,75 @@ namespace rvv::experimental { inline namespace parallelism_v2 {
         return {min(x, y), max(x, y)};
     }
 
+    // permute returns x with lane i taken from lane idx[i], indices past the
+    // last lane give 0
+    template <typename T_, typename Abi_>
+    inline simd<T_, Abi_> permute(const simd<T_, Abi_>& x,
+        const simd<rvv_impl::index_of<T_>, Abi_>& idx)
+    {
+        return simd<T_, Abi_>::Impl::gather(x.vec, idx.vec, x.size());
+    }
+
+    // slide_up moves the lanes of x up by n, lane i is lane i - n of x and
+    // the lanes below n are 0
+    template <typename T_, typename Abi_>
+    inline simd<T_, Abi_> slide_up(const simd<T_, Abi_>& x, std::size_t n)
+    {
+        return simd<T_, Abi_>::Impl::slide_up(
+            simd<T_, Abi_>(T_(0)).vec, x.vec, n, x.size());
+    }
+
+    // slide_down moves the lanes of x down by n, lane i is lane i + n of x
+    // and the lanes from size() - n on are 0
+    template <typename T_, typename Abi_>
+    inline simd<T_, Abi_> slide_down(const simd<T_, Abi_>& x, std::size_t n)
+    {
+        return simd<T_, Abi_>::Impl::slide_down(x.vec, n, x.size());
+    }
+
+    // gather loads ptr[idx[i]] into lane i, the byte offsets of the
+    // elements have to fit in the index type
+    template <typename T_, typename Abi_>
+    inline simd<T_, Abi_> gather(
+        const T_* ptr, const simd<rvv_impl::index_of<T_>, Abi_>& idx)
+    {
+        return simd<T_, Abi_>::Impl::load_indexed(ptr, idx.vec);
+    }
+
+    // gather of the first n lanes, the others are unspecified
+    template <typename T_, typename Abi_>
+    inline simd<T_, Abi_> gather(const T_* ptr,
+        const simd<rvv_impl::index_of<T_>, Abi_>& idx, std::size_t n)
+    {
+        return simd<T_, Abi_>::Impl::load_indexed(ptr, idx.vec, n);
+    }
+
+    // scatter stores lane i of x to ptr[idx[i]], when lanes share an index
+    // one of them is stored
+    template <typename T_, typename Abi_>
+    inline void scatter(const simd<T_, Abi_>& x, T_* ptr,
+        const simd<rvv_impl::index_of<T_>, Abi_>& idx)
+    {
+        simd<T_, Abi_>::Impl::store_indexed(x.vec, ptr, idx.vec);
+    }
+
+    // scatter of the first n lanes
+    template <typename T_, typename Abi_>
+    inline void scatter(const simd<T_, Abi_>& x, T_* ptr,
+        const simd<rvv_impl::index_of<T_>, Abi_>& idx, std::size_t n)
+    {
+        simd<T_, Abi_>::Impl::store_indexed(x.vec, ptr, idx.vec, n);
+    }
+
+    // reverse returns the lanes of x in reverse order
+    template <typename T, typename Abi>
+    inline simd<T, Abi> reverse(const simd<T, Abi>& x)
+    {
+        using U = rvv_impl::index_of<T>;
+        return permute(x,
+            simd<U, Abi>(U(x.size() - 1)) - simd<U, Abi>(simd<U, Abi>::index0123));
+    }
+
     template <typename T_, typename Abi_>
     inline simd<T_, Abi_> copysign(const simd<T_, Abi_>& valSrc, const simd<T_, Abi_>& signSrc) {
         static_assert(std::is_floating_point_v<T_>, "copysign only works for floating point types");
@@ -1524,6 +2501,54 @@ namespace rvv::experimental { inline namespace parallelism_v2 {
         return __riscv_vfsqrt(x.vec, x.size());
     }
 
+    // reciprocal_estimate and rsqrt_estimate are accurate to 7 bits, use
+    // reciprocal<Iter> and rsqrt<Iter> to refine them
+    template <typename T_, typename Abi_>
+    inline simd<T_, Abi_> reciprocal_estimate(const simd<T_, Abi_>& x)
+    {
+        static_assert(std::is_floating_point_v<T_>, "reciprocal_estimate only works for floating point types");
+        return __riscv_vfrec7(x.vec, x.size());
+    }
+
+    template <typename T_, typename Abi_>
+    inline simd<T_, Abi_> rsqrt_estimate(const simd<T_, Abi_>& x)
+    {
+        static_assert(std::is_floating_point_v<T_>, "rsqrt_estimate only works for floating point types");
+        return __riscv_vfrsqrt7(x.vec, x.size());
+    }
+
+    // 1 / x, each Newton-Raphson step roughly doubles the number of correct
+    // bits of the estimate: 14 bits after one step, 28 after two
+    template <int Iter = 1, typename T, typename Abi>
+    inline simd<T, Abi> reciprocal(const simd<T, Abi>& x)
+    {
+        static_assert(Iter >= 0, "number of iterations can't be negative");
+        auto y = reciprocal_estimate(x);
+        for (int i = 0; i < Iter; i++)
+        {
+            // y = y * (2 - x * y)
+            auto e = fma(-x, y, simd<T, Abi>(T(1)));
+            y = fma(y, e, y);
+        }
+        return y;
+    }
+
+    // 1 / sqrt(x), with the same precision per step as reciprocal
+    template <int Iter = 1, typename T, typename Abi>
+    inline simd<T, Abi> rsqrt(const simd<T, Abi>& x)
+    {
+        static_assert(Iter >= 0, "number of iterations can't be negative");
+        auto y = rsqrt_estimate(x);
+        auto half_x = x * T(0.5);
+        for (int i = 0; i < Iter; i++)
+        {
+            // y = y * (1.5 - 0.5 * x * y * y)
+            auto e = fma(-half_x * y, y, simd<T, Abi>(T(1.5)));
+            y = y * e;
+        }
+        return y;
+    }
+
     template <typename T_, typename Abi_>
     inline simd<T_, Abi_> abs(const simd<T_, Abi_>& x)
     {
@@ -1543,12 +2568,380 @@ namespace rvv::experimental { inline namespace parallelism_v2 {
         }
     }
 
-//     template <typename T_, typename Abi_>
-//     inline simd<T_, Abi_> fma(const simd<T_, Abi_>& a, const simd<T_, Abi_>& b,
-//         const simd<T_, Abi_>& z)
-//     {
-//         return svmad_m(a.all_true, a.vec, b.vec, z.vec);
-//     }
+    // fma computes a * b + z, for floating types without intermediate rounding
+    template <typename T_, typename Abi_>
+    inline simd<T_, Abi_> fma(const simd<T_, Abi_>& a, const simd<T_, Abi_>& b,
+        const simd<T_, Abi_>& z)
+    {
+        return simd<T_, Abi_>::Impl::fma(a.vec, b.vec, z.vec, a.size());
+    }
+
+    // static_simd_cast converts each element to U, which must have the same
+    // width as T so that the number of elements is preserved
+    template <typename U_, typename T_, typename Abi_>
+    inline simd<U_, Abi_> static_simd_cast(const simd<T_, Abi_>& x)
+    {
+        static_assert(sizeof(U_) == sizeof(T_),
+            "static_simd_cast only works between types of the same size");
+        return rvv_impl::convert<U_, T_>(x.vec, x.size());
+    }
+
+    // simd_bit_cast reinterprets the bits of each element as U
+    template <typename U_, typename T_, typename Abi_>
+    inline simd<U_, Abi_> simd_bit_cast(const simd<T_, Abi_>& x)
+    {
+        static_assert(sizeof(U_) == sizeof(T_),
+            "simd_bit_cast only works between types of the same size");
+        return rvv_impl::reinterpret<U_, T_>(x.vec);
+    }
+
+    // to_int converts to the signed integral type of the same width, rounding
+    // with R. Out of range values saturate to the limits of the integral
+    // type, NaN converts to its maximum.
+    template <rounding_mode R, typename T_, typename Abi_>
+    inline simd<rvv_impl::integral_of<T_>, Abi_> to_int(const simd<T_, Abi_>& x)
+    {
+        static_assert(std::is_floating_point_v<T_>, "to_int only works for floating point types");
+        return rvv_impl::convert_rounding<rvv_impl::integral_of<T_>, T_,
+            static_cast<unsigned>(R)>(x.vec, x.size());
+    }
+
+    // to_int without rounding mode truncates towards zero, like static_cast
+    template <typename T, typename Abi>
+    inline simd<rvv_impl::integral_of<T>, Abi> to_int(const simd<T, Abi>& x)
+    {
+        return to_int<rounding_mode::toward_zero>(x);
+    }
+
+    // to_float converts to the floating type of the same width, rounding to
+    // nearest
+    template <typename T, typename Abi>
+    inline simd<rvv_impl::floating_of<T>, Abi> to_float(const simd<T, Abi>& x)
+    {
+        static_assert(std::is_integral_v<T>, "to_float only works for integral types");
+        return static_simd_cast<rvv_impl::floating_of<T>>(x);
+    }
+
+    namespace rounding_impl {
+        // Round to an integral value with R. Values of magnitude 2^digits
+        // and above are already integral and, like NaN and inf, are passed
+        // through unchanged. The sign is restored so that e.g. ceil(-0.5)
+        // is -0.
+        template <rounding_mode R, typename T, typename Abi>
+        inline simd<T, Abi> round_integral(const simd<T, Abi>& x)
+        {
+            static_assert(std::is_floating_point_v<T>, "rounding only works for floating point types");
+            const simd<T, Abi> limit(T(1) / std::numeric_limits<T>::epsilon());
+            auto rounded = copysign(to_float(to_int<R>(x)), x);
+            return choose(abs(x) < limit, rounded, x);
+        }
+    }    // namespace rounding_impl
+
+    template <typename T, typename Abi>
+    inline simd<T, Abi> floor(const simd<T, Abi>& x)
+    {
+        return rounding_impl::round_integral<rounding_mode::downward>(x);
+    }
+
+    template <typename T, typename Abi>
+    inline simd<T, Abi> ceil(const simd<T, Abi>& x)
+    {
+        return rounding_impl::round_integral<rounding_mode::upward>(x);
+    }
+
+    template <typename T, typename Abi>
+    inline simd<T, Abi> trunc(const simd<T, Abi>& x)
+    {
+        return rounding_impl::round_integral<rounding_mode::toward_zero>(x);
+    }
+
+    // round rounds halfway cases away from zero
+    template <typename T, typename Abi>
+    inline simd<T, Abi> round(const simd<T, Abi>& x)
+    {
+        return rounding_impl::round_integral<rounding_mode::nearest_away>(x);
+    }
+
+    // nearbyint rounds with the current rounding mode
+    template <typename T, typename Abi>
+    inline simd<T, Abi> nearbyint(const simd<T, Abi>& x)
+    {
+        return rounding_impl::round_integral<rounding_mode::dynamic>(x);
+    }
+
+    // lround returns the signed integral type of the same width as T
+    // (saturating), rounding halfway cases away from zero
+    template <typename T, typename Abi>
+    inline simd<rvv_impl::integral_of<T>, Abi> lround(const simd<T, Abi>& x)
+    {
+        return to_int<rounding_mode::nearest_away>(x);
+    }
+
+    // is_fp_class is true for elements in any of the fp_class Classes
+    template <unsigned Classes, typename T_, typename Abi_>
+    inline simd_mask<T_, Abi_> is_fp_class(const simd<T_, Abi_>& x)
+    {
+        static_assert(std::is_floating_point_v<T_>, "is_fp_class only works for floating point types");
+        return simd<T_, Abi_>::Impl::classify(x.vec, Classes, x.size());
+    }
+
+    template <typename T, typename Abi>
+    inline simd_mask<T, Abi> isnan(const simd<T, Abi>& x)
+    {
+        return is_fp_class<fp_class::nan>(x);
+    }
+
+    template <typename T, typename Abi>
+    inline simd_mask<T, Abi> isinf(const simd<T, Abi>& x)
+    {
+        return is_fp_class<fp_class::infinity>(x);
+    }
+
+    template <typename T, typename Abi>
+    inline simd_mask<T, Abi> isfinite(const simd<T, Abi>& x)
+    {
+        return is_fp_class<fp_class::finite>(x);
+    }
+
+    template <typename T, typename Abi>
+    inline simd_mask<T, Abi> isnormal(const simd<T, Abi>& x)
+    {
+        return is_fp_class<fp_class::normal>(x);
+    }
+
+    // signbit reads the sign bit directly since vfclass doesn't report the
+    // sign of NaN
+    template <typename T, typename Abi>
+    inline simd_mask<T, Abi> signbit(const simd<T, Abi>& x)
+    {
+        static_assert(std::is_floating_point_v<T>, "signbit only works for floating point types");
+        using int_t = rvv_impl::integral_of<T>;
+        return simd_mask<T, Abi>(
+            simd_bit_cast<int_t>(x) < simd<int_t, Abi>(int_t(0)));
+    }
+
+    // fpclassify returns one of FP_NAN, FP_INFINITE, FP_ZERO, FP_SUBNORMAL
+    // or FP_NORMAL per element, as the signed integral type of the same
+    // width. A single vfclass, the classes are tested on its result
+    template <typename T_, typename Abi_>
+    inline simd<rvv_impl::integral_of<T_>, Abi_> fpclassify(const simd<T_, Abi_>& x)
+    {
+        static_assert(std::is_floating_point_v<T_>, "fpclassify only works for floating point types");
+        using int_t = rvv_impl::integral_of<T_>;
+        using U = rvv_impl::index_of<T_>;
+        using int_mask = simd_mask<int_t, Abi_>;
+        const simd<U, Abi_> cls(simd<T_, Abi_>::Impl::fclass(x.vec, x.size()));
+        auto in = [&](unsigned classes) {
+            return int_mask((cls & U(classes)) != simd<U, Abi_>(U(0)));
+        };
+        simd<int_t, Abi_> result(int_t(FP_NORMAL));
+        result = choose(in(fp_class::subnormal),
+            simd<int_t, Abi_>(int_t(FP_SUBNORMAL)), result);
+        result = choose(in(fp_class::zero),
+            simd<int_t, Abi_>(int_t(FP_ZERO)), result);
+        result = choose(in(fp_class::infinity),
+            simd<int_t, Abi_>(int_t(FP_INFINITE)), result);
+        return choose(in(fp_class::nan),
+            simd<int_t, Abi_>(int_t(FP_NAN)), result);
+    }
+
+    // Bit manipulation, signed types are treated as their unsigned bits
+
+    // popcount counts the set bits of each element
+    template <typename T_, typename Abi_>
+    inline simd<T_, Abi_> popcount(const simd<T_, Abi_>& x)
+    {
+        static_assert(std::is_integral_v<T_>, "popcount only works for integeral types");
+        using U = std::make_unsigned_t<T_>;
+        return rvv_impl::reinterpret<T_, U>(rvv_impl::popcount<U>(
+            rvv_impl::reinterpret<U, T_>(x.vec), x.size()));
+    }
+
+    // countl_zero counts the zero bits above the highest set bit
+    template <typename T_, typename Abi_>
+    inline simd<T_, Abi_> countl_zero(const simd<T_, Abi_>& x)
+    {
+        static_assert(std::is_integral_v<T_>, "countl_zero only works for integeral types");
+        using U = std::make_unsigned_t<T_>;
+        return rvv_impl::reinterpret<T_, U>(rvv_impl::countl_zero<U>(
+            rvv_impl::reinterpret<U, T_>(x.vec), x.size()));
+    }
+
+    // countr_zero counts the zero bits below the lowest set bit
+    template <typename T_, typename Abi_>
+    inline simd<T_, Abi_> countr_zero(const simd<T_, Abi_>& x)
+    {
+        static_assert(std::is_integral_v<T_>, "countr_zero only works for integeral types");
+        using U = std::make_unsigned_t<T_>;
+        return rvv_impl::reinterpret<T_, U>(rvv_impl::countr_zero<U>(
+            rvv_impl::reinterpret<U, T_>(x.vec), x.size()));
+    }
+
+    // byteswap reverses the bytes of each element
+    template <typename T_, typename Abi_>
+    inline simd<T_, Abi_> byteswap(const simd<T_, Abi_>& x)
+    {
+        static_assert(std::is_integral_v<T_>, "byteswap only works for integeral types");
+        using U = std::make_unsigned_t<T_>;
+        return rvv_impl::reinterpret<T_, U>(rvv_impl::byteswap<U>(
+            rvv_impl::reinterpret<U, T_>(x.vec), x.size()));
+    }
+
+    // bit_reverse reverses the bits of each element
+    template <typename T_, typename Abi_>
+    inline simd<T_, Abi_> bit_reverse(const simd<T_, Abi_>& x)
+    {
+        static_assert(std::is_integral_v<T_>, "bit_reverse only works for integeral types");
+        using U = std::make_unsigned_t<T_>;
+        return rvv_impl::reinterpret<T_, U>(rvv_impl::bit_reverse<U>(
+            rvv_impl::reinterpret<U, T_>(x.vec), x.size()));
+    }
+
+    // andn computes x & ~y
+    template <typename T_, typename Abi_>
+    inline simd<T_, Abi_> andn(const simd<T_, Abi_>& x, const simd<T_, Abi_>& y)
+    {
+        static_assert(std::is_integral_v<T_>, "andn only works for integeral types");
+        using U = std::make_unsigned_t<T_>;
+        return rvv_impl::reinterpret<T_, U>(
+            rvv_impl::andn<U>(rvv_impl::reinterpret<U, T_>(x.vec),
+                rvv_impl::reinterpret<U, T_>(y.vec), x.size()));
+    }
+
+    // clmul returns the low 64 bits of the carry-less product of x and y
+    template <typename T_, typename Abi_>
+    inline simd<T_, Abi_> clmul(const simd<T_, Abi_>& x, const simd<T_, Abi_>& y)
+    {
+        static_assert(std::is_same_v<T_, uint64_t>, "clmul only works for uint64_t");
+        return rvv_impl::clmul(x.vec, y.vec, x.size());
+    }
+
+    // clmulh returns the high 64 bits of the carry-less product of x and y
+    template <typename T_, typename Abi_>
+    inline simd<T_, Abi_> clmulh(const simd<T_, Abi_>& x, const simd<T_, Abi_>& y)
+    {
+        static_assert(std::is_same_v<T_, uint64_t>, "clmulh only works for uint64_t");
+        return rvv_impl::clmulh(x.vec, y.vec, x.size());
+    }
+
+    // mulhi returns the high half of the double width product x * y
+    template <typename T_, typename Abi_>
+    inline simd<T_, Abi_> mulhi(const simd<T_, Abi_>& x, const simd<T_, Abi_>& y)
+    {
+        static_assert(std::is_integral_v<T_>, "mulhi only works for integeral types");
+        return simd<T_, Abi_>::Impl::multiply_high(x.vec, y.vec, x.size());
+    }
+
+    // mulhsu returns the high half of the product of signed x and unsigned y
+    template <typename T_, typename Abi_>
+    inline simd<T_, Abi_> mulhsu(const simd<T_, Abi_>& x,
+        const simd<std::make_unsigned_t<T_>, Abi_>& y)
+    {
+        static_assert(rvv_impl::SignedSIMD<T_>, "mulhsu only works for signed integeral types");
+        return simd<T_, Abi_>::Impl::multiply_high_su(x.vec, y.vec, x.size());
+    }
+
+    // Division by an invariant divisor with a multiply high and shifts
+    // instead of vdiv (Granlund and Montgomery, "Division by invariant
+    // integers using multiplication"). Construct it once outside the loop;
+    // x / d rounds toward zero like operator/. The divisor must not be 0.
+    template <typename T>
+    class divider
+    {
+        static_assert(std::is_integral_v<T>, "divider only works for integeral types");
+        using U = std::make_unsigned_t<T>;
+        using wide = unsigned __int128;
+        static constexpr int bits = 8 * sizeof(T);
+
+        T d;
+        T multiplier;
+        int shift1 = 0;
+        int shift2 = 0;
+        T sign = 0;
+
+    public:
+        constexpr explicit divider(T divisor) : d(divisor)
+        {
+            const U abs_d = divisor < 0 ? U(U(0) - U(divisor)) : U(divisor);
+            // l = ceil(log2 |d|)
+            int l = 0;
+            while (l < bits && (wide(1) << l) < abs_d)
+                l++;
+            if constexpr (std::is_unsigned_v<T>)
+            {
+                // m = floor(2^w (2^l - d) / d) + 1, q = (t + ((x - t) >> 1)) >> (l - 1)
+                // with t = mulhi(m, x)
+                multiplier = T((((wide(1) << l) - abs_d) << bits) / abs_d + 1);
+                shift1 = std::min(l, 1);
+                shift2 = std::max(l - 1, 0);
+            }
+            else
+            {
+                // m = 2^(w + l - 1) / |d| + 1 - 2^w, q = ((x + mulhi(m, x)) >> (l - 1))
+                // - (x >> (w - 1)), negated for a negative divisor
+                l = std::max(l, 1);
+                multiplier = T(U((wide(1) << (bits + l - 1)) / abs_d + 1 - (wide(1) << bits)));
+                shift1 = l - 1;
+                sign = divisor < 0 ? T(-1) : T(0);
+            }
+        }
+
+        constexpr T divisor() const
+        {
+            return d;
+        }
+
+        template <typename Abi>
+        inline friend simd<T, Abi> operator/(const simd<T, Abi>& x, const divider& div)
+        {
+            if constexpr (std::is_unsigned_v<T>)
+            {
+                simd<T, Abi> t = mulhi(x, simd<T, Abi>(div.multiplier));
+                return (t + ((x - t) >> div.shift1)) >> div.shift2;
+            }
+            else
+            {
+                simd<T, Abi> q = x + mulhi(x, simd<T, Abi>(div.multiplier));
+                q = (q >> div.shift1) - (x >> (bits - 1));
+                return (q ^ simd<T, Abi>(div.sign)) - simd<T, Abi>(div.sign);
+            }
+        }
+
+        template <typename Abi>
+        inline friend simd<T, Abi> operator%(const simd<T, Abi>& x, const divider& div)
+        {
+            return x - (x / div) * simd<T, Abi>(div.d);
+        }
+    };
+
+    // divide_by<D>(x) is x / D with the constants of the division computed
+    // at compile time, powers of two become shifts
+    template <auto D, typename T, typename Abi>
+    inline simd<T, Abi> divide_by(const simd<T, Abi>& x)
+    {
+        static_assert(D != 0, "division by zero");
+        using U = std::make_unsigned_t<T>;
+        constexpr T d = T(D);
+        constexpr U abs_d = d < 0 ? U(U(0) - U(d)) : U(d);
+        constexpr int k = std::countr_zero(abs_d);
+        if constexpr (abs_d == 1)
+            return d < 0 ? simd<T, Abi>(T(0)) - x : x;
+        else if constexpr (std::has_single_bit(abs_d) && std::is_unsigned_v<T>)
+            return x >> k;
+        else if constexpr (std::has_single_bit(abs_d))
+        {
+            // round toward zero: add 2^k - 1 to negative x before shifting
+            constexpr int bits = 8 * sizeof(T);
+            simd<U, Abi> bias = simd_bit_cast<U>(x >> (bits - 1)) >> (bits - k);
+            simd<T, Abi> q = (x + simd_bit_cast<T>(bias)) >> k;
+            return d < 0 ? simd<T, Abi>(T(0)) - q : q;
+        }
+        else
+        {
+            static constexpr divider<T> div(d);
+            return x / div;
+        }
+    }
 
     template <typename T, typename Abi, typename Op = std::plus<>>
     inline T reduce(const simd<T, Abi>& x, Op op = {})
@@ -1745,6 +3138,15 @@ namespace rvv::experimental { inline namespace parallelism_v2 {
             pred = p;
         }
 
+        // masks of element types with the same width share the predicate
+        // layout, so converting between them is free
+        template <typename U>
+            requires(sizeof(U) == sizeof(T) && !std::is_same_v<U, T>)
+        inline explicit simd_mask(const simd_mask<U, Abi>& other)
+        {
+            pred = other.pred;
+        }
+
         // ----------------------------------------------------------------------
         //  get and set
         // ----------------------------------------------------------------------
@@ -1904,9 +3306,10 @@ namespace rvv::experimental { inline namespace parallelism_v2 {
             return (c > 0) && (c < (int) size());
         }
 
+        // index of the first set lane, -1 if there is none
         inline int find_first_set() const
         {
-            return __riscv_vfirst(pred);
+            return __riscv_vfirst(pred, size());
         }
 
 //         inline int find_last_set() const
@@ -1924,6 +3327,9 @@ namespace rvv::experimental { inline namespace parallelism_v2 {
 //         }
 
     private:
+        template <typename T_, typename Abi_>
+        friend class simd_mask;
+
         template <typename T_, typename Abi_>
         inline friend simd<T_, Abi_> choose(const simd_mask<T_, Abi_>& msk,
             const simd<T_, Abi_>& t, const simd<T_, Abi_>& f);
@@ -1932,9 +3338,19 @@ namespace rvv::experimental { inline namespace parallelism_v2 {
         inline friend void mask_assign(const simd_mask<T_, Abi_>& msk,
             simd<T_, Abi_>& v, const simd<T_, Abi_>& val);
 
-//         template <typename T_, typename Abi_>
-//         inline friend simd<T_, Abi_> compact(
-//             const simd_mask<T_, Abi_>& msk, const simd<T_, Abi_>& v);
+        template <typename T_, typename Abi_>
+        inline friend simd<T_, Abi_> add_with_carry(const simd<T_, Abi_>& x,
+            const simd<T_, Abi_>& y, const simd_mask<T_, Abi_>& carry_in,
+            simd_mask<T_, Abi_>& carry_out);
+
+        template <typename T_, typename Abi_>
+        inline friend simd<T_, Abi_> sub_with_borrow(const simd<T_, Abi_>& x,
+            const simd<T_, Abi_>& y, const simd_mask<T_, Abi_>& borrow_in,
+            simd_mask<T_, Abi_>& borrow_out);
+
+        template <typename T_, typename Abi_>
+        inline friend simd<T_, Abi_> compact(
+            const simd_mask<T_, Abi_>& msk, const simd<T_, Abi_>& v);
 
 //         template <typename T_, typename Abi_>
 //         inline friend simd<T_, Abi_> splice(const simd_mask<T_, Abi_>& msk,
@@ -1997,15 +3413,42 @@ namespace rvv::experimental { inline namespace parallelism_v2 {
         v.vec = __riscv_vmerge(v.vec, val.vec, msk.pred, v.size());
     }
 
-//     template <typename T, typename Abi>
-//     inline simd<T, Abi> compact(
-//         const simd_mask<T, Abi>& msk, const simd<T, Abi>& v)
-//     {
-//         static_assert(sizeof(T) >= 4,
-//             "compact function only works with airthmetic types which\
-//          are atleast 4 bytes in size");
-//         return svcompact(msk.pred, v.vec);
-//     }
+    // add_with_carry returns x + y + carry_in and sets carry_out where the
+    // sum overflowed, chaining it through the limbs of wider integers
+    template <typename T, typename Abi>
+    inline simd<T, Abi> add_with_carry(const simd<T, Abi>& x,
+        const simd<T, Abi>& y, const simd_mask<T, Abi>& carry_in,
+        simd_mask<T, Abi>& carry_out)
+    {
+        static_assert(rvv_impl::UnignedSIMD<T>, "add_with_carry only works for unsigned integeral types");
+        using Impl = typename simd<T, Abi>::Impl;
+        simd<T, Abi> sum = Impl::add_carry(x.vec, y.vec, carry_in.pred, x.size());
+        carry_out.pred = Impl::carry_out(x.vec, y.vec, carry_in.pred, x.size());
+        return sum;
+    }
+
+    // sub_with_borrow returns x - y - borrow_in and sets borrow_out where
+    // the difference went below zero
+    template <typename T, typename Abi>
+    inline simd<T, Abi> sub_with_borrow(const simd<T, Abi>& x,
+        const simd<T, Abi>& y, const simd_mask<T, Abi>& borrow_in,
+        simd_mask<T, Abi>& borrow_out)
+    {
+        static_assert(rvv_impl::UnignedSIMD<T>, "sub_with_borrow only works for unsigned integeral types");
+        using Impl = typename simd<T, Abi>::Impl;
+        simd<T, Abi> difference = Impl::sub_borrow(x.vec, y.vec, borrow_in.pred, x.size());
+        borrow_out.pred = Impl::borrow_out(x.vec, y.vec, borrow_in.pred, x.size());
+        return difference;
+    }
+
+    // compact packs the lanes of v selected by msk to the front, the lanes
+    // after the first popcount(msk) are unspecified
+    template <typename T, typename Abi>
+    inline simd<T, Abi> compact(
+        const simd_mask<T, Abi>& msk, const simd<T, Abi>& v)
+    {
+        return simd<T, Abi>::Impl::compress(v.vec, msk.pred, v.size());
+    }
 
 //     template <typename T_, typename Abi_>
 //     inline simd<T_, Abi_> splice(const simd_mask<T_, Abi_>& msk,
@@ -0,0 +1,241 @@
+#pragma once
+
+#include <rvv/rvv.hpp>
+#include <rvv/algorithms.hpp>
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <type_traits>
+
+// Sorting of the lanes of a register and of arrays.
+//
+// sort(simd&) is a bitonic network: log2(N) * (log2(N) + 1) / 2 steps that
+// each permute the register against itself and keep the min or the max per
+// lane. merge() combines two sorted registers with the last log2(N) + 1
+// steps of the network.
+//
+// rvv::sort is a quicksort on top of the in-place vectorized
+// algorithms::partition with a compare mask against the pivot. Ranges of up
+// to two registers are sorted with the networks.
+//
+// Only std::less and std::greater orders are supported. Floating point
+// ranges must not contain NaN.
+
+namespace rvv::experimental { inline namespace parallelism_v2 {
+
+    namespace sort_impl {
+
+        template <typename Compare, typename T>
+        inline constexpr bool is_descending()
+        {
+            constexpr bool less = std::is_same_v<Compare, std::less<>> ||
+                std::is_same_v<Compare, std::less<T>>;
+            constexpr bool greater = std::is_same_v<Compare, std::greater<>> ||
+                std::is_same_v<Compare, std::greater<T>>;
+            static_assert(less || greater,
+                "sort only supports std::less and std::greater");
+            return greater;
+        }
+
+        template <typename T, typename Abi>
+        inline simd<rvv_impl::index_of<T>, Abi> lanes()
+        {
+            using U = rvv_impl::index_of<T>;
+            return simd<U, Abi>(simd<U, Abi>::index0123);
+        }
+
+        // lanes with (lane & bit) == 0 as a mask of T
+        template <typename T, typename Abi>
+        inline simd_mask<T, Abi> bit_clear(std::size_t bit)
+        {
+            using U = rvv_impl::index_of<T>;
+            auto m = (lanes<T, Abi>() & U(bit)) == simd<U, Abi>(U(0));
+            if constexpr (std::is_same_v<T, U>)
+                return m;
+            else
+                return simd_mask<T, Abi>(m);
+        }
+
+        // Compare exchange of every lane i with lane i ^ j, the lanes in
+        // keep_min take the smaller value
+        template <typename T, typename Abi>
+        inline simd<T, Abi> exchange(const simd<T, Abi>& x, std::size_t j,
+            const simd_mask<T, Abi>& keep_min)
+        {
+            using U = rvv_impl::index_of<T>;
+            simd<T, Abi> y = permute(x, lanes<T, Abi>() ^ U(j));
+            return choose(keep_min, min(x, y), max(x, y));
+        }
+
+        // sorts a bitonic sequence
+        template <bool Descending, typename T, typename Abi>
+        inline simd<T, Abi> bitonic_merge(simd<T, Abi> x)
+        {
+            for (std::size_t j = x.size() / 2; j > 0; j /= 2)
+            {
+                auto lower = bit_clear<T, Abi>(j);
+                x = exchange(x, j, Descending ? !lower : lower);
+            }
+            return x;
+        }
+    }    // namespace sort_impl
+
+    // sorts the lanes of x in ascending order, or descending with
+    // std::greater
+    template <typename T, typename Abi, typename Compare = std::less<>>
+    inline void sort(simd<T, Abi>& x, Compare = {})
+    {
+        constexpr bool descending = sort_impl::is_descending<Compare, T>();
+        for (std::size_t k = 2; k <= x.size(); k *= 2)
+        {
+            // blocks of k lanes alternate between ascending and descending
+            auto ascending = sort_impl::bit_clear<T, Abi>(k);
+            for (std::size_t j = k / 2; j > 0; j /= 2)
+            {
+                auto keep_min = !(ascending ^ sort_impl::bit_clear<T, Abi>(j));
+                x = sort_impl::exchange(x, j, descending ? !keep_min : keep_min);
+            }
+        }
+    }
+
+    // Merges the sorted registers lo and hi, afterwards lo holds the first
+    // and hi the last size() values of the sorted sequence
+    template <typename T, typename Abi, typename Compare = std::less<>>
+    inline void merge(simd<T, Abi>& lo, simd<T, Abi>& hi, Compare = {})
+    {
+        constexpr bool descending = sort_impl::is_descending<Compare, T>();
+        simd<T, Abi> r = reverse(hi);
+        simd<T, Abi> a = descending ? max(lo, r) : min(lo, r);
+        simd<T, Abi> b = descending ? min(lo, r) : max(lo, r);
+        lo = sort_impl::bitonic_merge<descending>(a);
+        hi = sort_impl::bitonic_merge<descending>(b);
+    }
+}}    // namespace rvv::experimental::parallelism_v2
+
+namespace rvv {
+
+    namespace quicksort_impl {
+
+        using namespace rvv::experimental;
+
+        // padding that sorts behind every value
+        template <typename T, bool Descending>
+        inline constexpr T sentinel()
+        {
+            using limits = std::numeric_limits<T>;
+            if constexpr (limits::has_infinity)
+                return Descending ? -limits::infinity() : limits::infinity();
+            else
+                return Descending ? limits::lowest() : limits::max();
+        }
+
+        // sorts up to two registers worth of elements
+        template <bool Descending, typename T>
+        inline void small_sort(T* p, std::size_t n)
+        {
+            constexpr std::size_t N = simd<T>::size();
+            const simd<T> pad(sentinel<T, Descending>());
+            const auto order = [] {
+                if constexpr (Descending)
+                    return std::greater<>{};
+                else
+                    return std::less<>{};
+            }();
+            simd<T> lo, hi;
+            if (n <= N)
+            {
+                lo.partial_copy_from(p, n);
+                lo = choose(algorithms_impl::first_lanes<T>(n), lo, pad);
+                experimental::sort(lo, order);
+                lo.partial_copy_to(p, n);
+                return;
+            }
+            lo.copy_from(p, element_aligned);
+            hi.partial_copy_from(p + N, n - N);
+            hi = choose(algorithms_impl::first_lanes<T>(n - N), hi, pad);
+            experimental::sort(lo, order);
+            experimental::sort(hi, order);
+            experimental::merge(lo, hi, order);
+            lo.copy_to(p, element_aligned);
+            hi.partial_copy_to(p + N, n - N);
+        }
+
+        // the median does not depend on the direction of the order
+        template <typename T>
+        inline T median_of_three(T a, T b, T c)
+        {
+            return std::max(std::min(a, b), std::min(std::max(a, b), c));
+        }
+
+        template <bool Descending, typename T>
+        inline void quicksort(T* p, std::size_t n, int depth)
+        {
+            constexpr std::size_t N = simd<T>::size();
+            while (n > 2 * N)
+            {
+                if (depth-- == 0)
+                {
+                    if constexpr (Descending)
+                        std::sort(p, p + n, std::greater<>{});
+                    else
+                        std::sort(p, p + n);
+                    return;
+                }
+                const simd<T> pivot(median_of_three(
+                    p[0], p[n / 2], p[n - 1]));
+                const std::span range(p, n);
+                std::size_t k = algorithms::partition(range,
+                    [&](const simd<T>& x) {
+                        return Descending ? x > pivot : x < pivot;
+                    });
+                if (k == 0)
+                {
+                    // the pivot comes first, its copies are in place
+                    k = algorithms::partition(range, [&](const simd<T>& x) {
+                        return Descending ? x >= pivot : x <= pivot;
+                    });
+                    p += k;
+                    n -= k;
+                    continue;
+                }
+                // recurse into the smaller part
+                if (k < n - k)
+                {
+                    quicksort<Descending>(p, k, depth);
+                    p += k;
+                    n -= k;
+                }
+                else
+                {
+                    quicksort<Descending>(p + k, n - k, depth);
+                    n = k;
+                }
+            }
+            small_sort<Descending>(p, n);
+        }
+    }    // namespace quicksort_impl
+
+    // sorts [first, last) in ascending order, or descending with
+    // std::greater, the order of equal elements is not preserved
+    template <typename T, typename Compare = std::less<>>
+    inline void sort(T* first, T* last, Compare = {})
+    {
+        constexpr bool descending =
+            experimental::sort_impl::is_descending<Compare, T>();
+        const std::size_t n = last - first;
+        if (n < 2)
+            return;
+        quicksort_impl::quicksort<descending>(first, n, 2 * std::bit_width(n));
+    }
+
+    template <std::ranges::contiguous_range R, typename Compare = std::less<>>
+    inline void sort(R&& range, Compare comp = {})
+    {
+        rvv::sort(std::ranges::data(range),
+            std::ranges::data(range) + std::ranges::size(range), comp);
+    }
+}    // namespace rvv
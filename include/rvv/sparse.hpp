@@ -0,0 +1,200 @@
+#pragma once
+
+#include <rvv/rvv.hpp>
+#include <rvv/algorithms.hpp>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+// Sparse matrix - vector products y = A * x for float and double.
+//
+// spmv_csr walks every row of a compressed sparse row matrix in chunks of
+// simd<T>::size() nonzeros: the column indices of a chunk gather the
+// matching elements of x, the products are accumulated per lane and reduced
+// across lanes once per row. Rows shorter than a register leave lanes idle.
+//
+// The sliced ELLPACK (SELL-C-sigma) format works on C = simd<T>::size()
+// rows at once, one row per lane. Rows are sorted by decreasing length
+// within windows of sigma rows, so that the C rows of a slice have similar
+// lengths, and every slice is stored column major with the width of its
+// longest row: step j of a slice loads the j-th nonzero of all its rows
+// with one contiguous load. Lanes past the end of their row are masked.
+//
+// Column indices have the width of T, for float the columns of x are
+// limited to 2^30.
+
+namespace rvv::sparse {
+
+    template <typename T>
+    using index_t = rvv_impl::index_of<T>;
+
+    // Compressed sparse row matrix: the nonzeros of row i are
+    // values[row_ptr[i]] .. values[row_ptr[i + 1] - 1] in the columns
+    // col[row_ptr[i]] .. col[row_ptr[i + 1] - 1]
+    template <typename T>
+    struct csr_matrix
+    {
+        std::size_t rows = 0;
+        std::size_t cols = 0;
+        std::vector<std::size_t> row_ptr;
+        std::vector<index_t<T>> col;
+        std::vector<T> values;
+    };
+
+    // Sliced ELLPACK matrix with slices of simd<T>::size() rows. Slice s
+    // holds the rows row[s * C] .. row[s * C + C - 1] of the original
+    // matrix, nonzero j of lane l is at slice_ptr[s] + j * C + l.
+    template <typename T>
+    struct sell_matrix
+    {
+        std::size_t rows = 0;
+        std::size_t cols = 0;
+        std::vector<std::size_t> slice_ptr;
+        // original row and number of nonzeros of every lane, padded to
+        // full slices with empty rows
+        std::vector<std::size_t> row;
+        std::vector<index_t<T>> length;
+        std::vector<index_t<T>> col;
+        std::vector<T> values;
+    };
+
+    namespace sparse_impl {
+
+        using namespace rvv::experimental;
+
+        template <typename T>
+        inline constexpr bool is_real =
+            std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+        // default sorting window, in rows
+        template <typename T>
+        inline constexpr std::size_t sigma = 16 * simd<T>::size();
+    }    // namespace sparse_impl
+
+    // y = A * x
+    template <typename T>
+    inline void spmv_csr(const csr_matrix<T>& a, const T* x, T* y)
+    {
+        using namespace sparse_impl;
+        using I = index_t<T>;
+        static_assert(is_real<T>, "spmv_csr only works for float and double");
+        constexpr std::size_t N = simd<T>::size();
+        const T* values = a.values.data();
+        const I* col = a.col.data();
+        for (std::size_t i = 0; i < a.rows; i++)
+        {
+            const std::size_t end = a.row_ptr[i + 1];
+            simd<T> acc(T(0));
+            std::size_t k = a.row_ptr[i];
+            for (; k + N <= end; k += N)
+                acc = fma(simd<T>(values + k, element_aligned),
+                    gather(x, simd<I>(col + k, element_aligned)), acc);
+            if (k < end)
+            {
+                // the indices past the row are zeroed to keep the gather in
+                // bounds, their products are dropped
+                const auto valid = algorithms_impl::first_lanes<I>(end - k);
+                simd<I> idx;
+                simd<T> v;
+                idx.partial_copy_from(col + k, end - k);
+                v.partial_copy_from(values + k, end - k);
+                idx = choose(valid, idx, simd<I>(I(0)));
+                acc = choose(algorithms_impl::mask_cast<T>(valid),
+                    fma(v, gather(x, idx), acc), acc);
+            }
+            y[i] = reduce(acc);
+        }
+    }
+
+    // Converts a CSR matrix to SELL-C-sigma, sigma is rounded up to a
+    // multiple of C = simd<T>::size()
+    template <typename T>
+    inline sell_matrix<T> to_sell(
+        const csr_matrix<T>& a, std::size_t sigma = sparse_impl::sigma<T>)
+    {
+        using I = index_t<T>;
+        constexpr std::size_t C = experimental::simd<T>::size();
+        sigma = std::max<std::size_t>(1, (sigma + C - 1) / C) * C;
+        const std::size_t slices = (a.rows + C - 1) / C;
+        auto length = [&](std::size_t i) {
+            return i < a.rows ? a.row_ptr[i + 1] - a.row_ptr[i] : 0;
+        };
+
+        sell_matrix<T> s;
+        s.rows = a.rows;
+        s.cols = a.cols;
+        s.row.resize(slices * C);
+        std::iota(s.row.begin(), s.row.end(), std::size_t(0));
+        for (std::size_t w = 0; w < s.row.size(); w += sigma)
+        {
+            auto window_end = s.row.begin() + std::min(w + sigma, s.row.size());
+            std::stable_sort(s.row.begin() + w, window_end,
+                [&](std::size_t i, std::size_t j) { return length(i) > length(j); });
+        }
+
+        s.length.resize(slices * C);
+        s.slice_ptr.resize(slices + 1);
+        for (std::size_t k = 0; k < slices; k++)
+        {
+            std::size_t width = 0;
+            for (std::size_t l = 0; l < C; l++)
+            {
+                s.length[k * C + l] = I(length(s.row[k * C + l]));
+                width = std::max(width, length(s.row[k * C + l]));
+            }
+            s.slice_ptr[k + 1] = s.slice_ptr[k] + width * C;
+        }
+
+        s.col.assign(s.slice_ptr[slices], I(0));
+        s.values.assign(s.slice_ptr[slices], T(0));
+        for (std::size_t k = 0; k < slices * C; k++)
+        {
+            const std::size_t base = s.slice_ptr[k / C] + k % C;
+            const std::size_t i = s.row[k];
+            for (std::size_t j = 0; j < length(i); j++)
+            {
+                s.col[base + j * C] = a.col[a.row_ptr[i] + j];
+                s.values[base + j * C] = a.values[a.row_ptr[i] + j];
+            }
+        }
+        return s;
+    }
+
+    // y = A * x
+    template <typename T>
+    inline void spmv(const sell_matrix<T>& a, const T* x, T* y)
+    {
+        using namespace sparse_impl;
+        using I = index_t<T>;
+        static_assert(is_real<T>, "spmv only works for float and double");
+        constexpr std::size_t C = simd<T>::size();
+        std::array<T, C> result;
+        for (std::size_t s = 0; s + 1 < a.slice_ptr.size(); s++)
+        {
+            const simd<I> length(a.length.data() + s * C, element_aligned);
+            const T* values = a.values.data() + a.slice_ptr[s];
+            const I* col = a.col.data() + a.slice_ptr[s];
+            const std::size_t width = (a.slice_ptr[s + 1] - a.slice_ptr[s]) / C;
+            simd<T> acc(T(0));
+            for (std::size_t j = 0; j < width; j++)
+            {
+                // padding is column 0 with value 0, masked so that it adds
+                // nothing even for a non finite x[0]
+                const auto active =
+                    algorithms_impl::mask_cast<T>(length > simd<I>(I(j)));
+                acc = choose(active,
+                    fma(simd<T>(values + j * C, element_aligned),
+                        gather(x, simd<I>(col + j * C, element_aligned)), acc),
+                    acc);
+            }
+            acc.copy_to(result.data(), element_aligned);
+            // the padding rows sort to the end of the last slice
+            const std::size_t lanes = std::min(C, a.rows - s * C);
+            for (std::size_t l = 0; l < lanes; l++)
+                y[a.row[s * C + l]] = result[l];
+        }
+    }
+}    // namespace rvv::sparse
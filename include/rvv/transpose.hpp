@@ -0,0 +1,160 @@
+#pragma once
+
+#include <rvv/rvv.hpp>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <type_traits>
+
+// Matrix transposes.
+//
+// transpose(std::array<simd, K>&) transposes K x K tiles held in K
+// registers with log2(K) butterfly steps: step d swaps the off diagonal
+// d x d blocks between the registers r and r + d: the upper half of each
+// 2d lane group of r + d slides up by d into r, the lower half of r slides
+// down by d into r + d, and a lane select keeps the rest of each register.
+//
+// rvv::transpose copies a row major matrix to its transpose block by block,
+// so that the rows of the source and of the destination that a block
+// touches stay in cache. Inside a block, full size() x size() tiles go
+// through the register transpose when a tile fits the register file. The
+// rest is copied row by row with strided stores into the destination
+// columns, or, when it has fewer columns than a register has lanes, column
+// by column with strided loads and contiguous stores so that every vector
+// is full. An array of structures is a matrix with a row per structure and
+// few columns, so it transposes into a structure of arrays a register of
+// each field at a time.
+
+namespace rvv::experimental { inline namespace parallelism_v2 {
+
+    // Transposes the K x K tiles held in x: register r holds row r of the
+    // size() / K tiles lying side by side, afterwards column r of each
+    template <typename T, typename Abi, std::size_t K>
+    inline void transpose(std::array<simd<T, Abi>, K>& x)
+    {
+        static_assert(std::has_single_bit(K) && K <= simd<T, Abi>::size(),
+            "transpose requires a power of two K up to simd::size()");
+        using U = rvv_impl::index_of<T>;
+        const simd<U, Abi> lane(simd<U, Abi>::index0123);
+        for (std::size_t d = K / 2; d > 0; d /= 2)
+        {
+            simd_mask<T, Abi> low;
+            if constexpr (std::is_same_v<T, U>)
+                low = (lane & U(d)) == simd<U, Abi>(U(0));
+            else
+                low = simd_mask<T, Abi>((lane & U(d)) == simd<U, Abi>(U(0)));
+            for (std::size_t r = 0; r < K; r++)
+            {
+                if (r & d)
+                    continue;
+                const simd<T, Abi> a = x[r], b = x[r + d];
+                x[r] = choose(low, a, slide_up(b, d));
+                x[r + d] = choose(low, slide_down(a, d), b);
+            }
+        }
+    }
+}}    // namespace rvv::experimental::parallelism_v2
+
+namespace rvv {
+
+    namespace transpose_impl {
+
+        using namespace rvv::experimental;
+
+        // elements per side of a cache block
+        inline constexpr std::size_t block = 64;
+        // largest tile, in registers, that goes through the register
+        // transpose
+        inline constexpr std::size_t max_register_tile = 16;
+
+        // rows x cols elements of src to dst, one strided load per chunk
+        // of a column
+        template <typename T>
+        inline void by_columns(const T* src, std::size_t lds, T* dst,
+            std::size_t ldd, std::size_t rows, std::size_t cols)
+        {
+            constexpr std::size_t N = simd<T>::size();
+            for (std::size_t j = 0; j < cols; j++)
+            {
+                for (std::size_t i = 0; i < rows; i += N)
+                {
+                    const std::size_t n = std::min(N, rows - i);
+                    simd<T> x;
+                    x.strided_copy_from(src + i * lds + j, lds, n);
+                    x.partial_copy_to(dst + j * ldd + i, n);
+                }
+            }
+        }
+
+        // rows x cols elements of src to dst, one strided store per chunk
+        // of a row, or by columns when the rows are shorter than a register
+        // and the columns are not
+        template <typename T>
+        inline void strided(const T* src, std::size_t lds, T* dst,
+            std::size_t ldd, std::size_t rows, std::size_t cols)
+        {
+            constexpr std::size_t N = simd<T>::size();
+            if (cols < N && cols < rows)
+            {
+                by_columns(src, lds, dst, ldd, rows, cols);
+                return;
+            }
+            for (std::size_t i = 0; i < rows; i++)
+            {
+                for (std::size_t j = 0; j < cols; j += N)
+                {
+                    const std::size_t n = std::min(N, cols - j);
+                    simd<T> x;
+                    x.partial_copy_from(src + i * lds + j, n);
+                    x.strided_copy_to(dst + j * ldd + i, ldd, n);
+                }
+            }
+        }
+
+        template <typename T>
+        inline void tile(const T* src, std::size_t lds, T* dst, std::size_t ldd)
+        {
+            constexpr std::size_t N = simd<T>::size();
+            std::array<simd<T>, N> x;
+            for (std::size_t r = 0; r < N; r++)
+                x[r].copy_from(src + r * lds, element_aligned);
+            experimental::transpose(x);
+            for (std::size_t r = 0; r < N; r++)
+                x[r].copy_to(dst + r * ldd, element_aligned);
+        }
+    }    // namespace transpose_impl
+
+    // Writes the transpose of the rows x cols matrix src to the cols x rows
+    // matrix dst, both row major, the matrices must not overlap
+    template <typename T>
+    inline void transpose(
+        const T* src, T* dst, std::size_t rows, std::size_t cols)
+    {
+        using namespace transpose_impl;
+        constexpr std::size_t N = simd<T>::size();
+        for (std::size_t ib = 0; ib < rows; ib += block)
+        {
+            for (std::size_t jb = 0; jb < cols; jb += block)
+            {
+                const std::size_t br = std::min(block, rows - ib);
+                const std::size_t bc = std::min(block, cols - jb);
+                const T* s = src + ib * cols + jb;
+                T* d = dst + jb * rows + ib;
+                if constexpr (N <= max_register_tile)
+                {
+                    const std::size_t tr = br / N * N;
+                    const std::size_t tc = bc / N * N;
+                    for (std::size_t i = 0; i < tr; i += N)
+                        for (std::size_t j = 0; j < tc; j += N)
+                            tile(s + i * cols + j, cols, d + j * rows + i, rows);
+                    // the columns right of the tiles, then the rows below
+                    strided(s + tc, cols, d + tc * rows, rows, tr, bc - tc);
+                    strided(s + tr * cols, cols, d + tr, rows, br - tr, bc);
+                }
+                else
+                    strided(s, cols, d, rows, br, bc);
+            }
+        }
+    }
+}    // namespace rvv
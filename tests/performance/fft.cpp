@@ -1,4 +1,5 @@
-#include <sve/sve.hpp>
+#include <rvv/rvv.hpp>
+#include <rvv/fft.hpp>
 #include <iostream>
 #include <vector>
 #include <numeric>
@@ -82,152 +83,23 @@ void fft(std::vector<T>& re, std::vector<T>& im, bool invert) {
     }
 }
 
-template <typename T>
-void fft_simd(std::vector<T>& re, std::vector<T>& im, bool invert) {
-    using simd_t = sve::experimental::simd<T>;
-    const T PI = acos(-1);
-
-    int n = re.size();
-
-    for (int i = 1, j = 0; i < n; i++) {
-        int bit = n >> 1;
-        for (; j & bit; bit >>= 1)
-            j ^= bit;
-        j ^= bit;
-
-        if (i < j)
-        {
-            std::swap(re[i], re[j]);
-            std::swap(im[i], im[j]);
-        }
-    }
-
-    for (int len = 2; len <= n; len <<= 1) {
-        if (len < 2 * (int)simd_t::size())
-        {
-            T ang = 2 * PI / len * (invert ? -1 : 1);
-
-            T wlen_re = cos(ang);
-            T wlen_im = sin(ang);
-            for (int i = 0; i < n; i += len) {
-
-                T w_re = 1;
-                T w_im = 0;
-
-                for (int j = 0; j < len / 2; j++) {
-                    int u = i+j;
-                    int v = i+j+len/2;
-
-                    T u_re = re[u];
-                    T u_im = im[u];
-                    T v_re = re[v];
-                    T v_im = im[v];
-                    complex_mul(v_re, v_im, w_re, w_im, v_re, v_im);
-
-                    re[u] = u_re + v_re;
-                    im[u] = u_im + v_im;
-
-                    re[v] = u_re - v_re;
-                    im[v] = u_im - v_im;
-
-                    complex_mul(w_re, w_im, wlen_re, wlen_im, w_re, w_im);
-                }
-            }
-        }
-        else
-        {
-            T ang = 2 * PI / len * (invert ? -1 : 1);
-            T cos_ang = cos(ang), sin_ang = sin(ang);
-            simd_t wlen_re(cos_ang);
-            simd_t wlen_im(sin_ang);
-            for (int i = 0; i < n; i += len) 
-            {
-                std::vector<T> w_re_arr(simd_t::size(), 0), w_im_arr(simd_t::size(), 0);
-                w_re_arr[0] = 1;
-                w_im_arr[0] = 0;
-                for (int k = 1; k < w_im_arr.size(); k++)
-                {
-                    complex_mul(w_re_arr[k-1], w_im_arr[k-1],cos_ang, sin_ang, w_re_arr[k], w_im_arr[k]);
-                }
-
-                simd_t w_re(w_re_arr.data(), sve::experimental::vector_aligned);
-                simd_t w_im(w_im_arr.data(), sve::experimental::vector_aligned);
-                auto w_re_init = w_re;
-                auto w_im_init = w_im;
-                for (int j = 0; j < len / 2; j += simd_t::size()) 
-                {
-                    int u = i+j;
-                    int v = i+j+len/2;
-
-                    simd_t u_re(re.data() + u, sve::experimental::vector_aligned);
-                    simd_t u_im(im.data() + u, sve::experimental::vector_aligned);
-                    simd_t v_re(re.data() + v, sve::experimental::vector_aligned);
-                    simd_t v_im(im.data() + v, sve::experimental::vector_aligned);
-
-                    complex_mul(v_re, v_im, w_re, w_im, v_re, v_im);
-
-                    auto uv_re = u_re + v_re;
-                    auto uv_im = u_im + v_im;
-                    uv_re.copy_to(re.data() + u, sve::experimental::vector_aligned);
-                    uv_im.copy_to(im.data() + u, sve::experimental::vector_aligned);
-
-                    uv_re = u_re - v_re;
-                    uv_im = u_im - v_im;
-                    uv_re.copy_to(re.data() + v, sve::experimental::vector_aligned);
-                    uv_im.copy_to(im.data() + v, sve::experimental::vector_aligned);
-
-                    complex_mul(w_re_init, w_im_init, 
-                            simd_t(w_re.last()), simd_t(w_im.last()), w_re, w_im);
-                    complex_mul(w_re, w_im, 
-                            wlen_re, wlen_im, w_re, w_im);
-                }
-            }  
-        }
-    }
-
-    if (invert) {
-        if (n < (int)simd_t::size())
-        {
-            for (T & x : re)
-                x /= n;
-            for (T & x : im)
-                x /= n;
-        }
-        else
-        {
-            for (int i = 0; i < n; i += simd_t::size())
-            {
-                simd_t v(re.data() + i, sve::experimental::vector_aligned);
-                v /= n;
-                v.copy_to(re.data() + i, sve::experimental::vector_aligned);
-            }
-
-            for (int i = 0; i < n; i += simd_t::size())
-            {
-                simd_t v(im.data() + i, sve::experimental::vector_aligned);
-                v /= n;
-                v.copy_to(im.data() + i, sve::experimental::vector_aligned);
-            }
-        }
-    }
-}
-
 template <typename T>
 double test_fft(T freq)
 {
     using cd = std::complex<T>;
     auto x = gen_signal(freq);
     auto x_re = x;
-    auto x_re_simd = x;
     std::vector<T> x_im(x_re.size(), 0);
-    std::vector<T> x_im_simd(x_re_simd.size(), 0);
+    const size_t n = x.size();
+    std::vector<T> zeros(n, 0), out_re(n), out_im(n);
+    rvv::fft::plan<T> plan(n);
     auto t1 = std::chrono::high_resolution_clock::now();
         fft(x_re, x_im, false);
     auto t2 = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> diff = t2 - t1;
 
     t1 = std::chrono::high_resolution_clock::now();
-    fft_simd(x_re_simd, x_im_simd, false);
+    plan.execute(x.data(), zeros.data(), out_re.data(), out_im.data());
     t2 = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> diff2 = t2 - t1;
     return diff.count() / diff2.count();
@@ -237,7 +109,7 @@ template <typename T>
 void test(int iterations)
 {
     std::fstream fout("fft.txt");
-    using simd_t = sve::experimental::simd<T>;
+    using simd_t = rvv::experimental::simd<T>;
     fout << "type\t\tsimd_len\t\tfrequency\t\tn_samples\t\tspeed_up\n";
     for (int i = 5; i <= 20; i++)
     {
@@ -255,8 +127,53 @@ void test(int iterations)
     }
 }
 
+// seconds per call of f, averaged over enough calls to take about 10 ms
+template <typename F>
+double time_per_call(F f)
+{
+    size_t calls = 1;
+    for (;;)
+    {
+        auto t1 = std::chrono::high_resolution_clock::now();
+        for (size_t i = 0; i < calls; i++)
+            f();
+        auto t2 = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double> diff = t2 - t1;
+        if (diff.count() > 0.01)
+            return diff.count() / calls;
+        calls *= 2;
+    }
+}
+
+// Throughput of repeated transforms with one plan, large lengths go through
+// the tiled bit reversal whose input rows are a power of two apart
+template <typename T>
+void test_execute(std::ofstream& fout)
+{
+    using simd_t = rvv::experimental::simd<T>;
+    for (int bits = 8; bits <= 22; bits += 2)
+    {
+        const size_t n = size_t(1) << bits;
+        std::vector<T> re(n, T(1)), im(n, T(0)), out_re(n), out_im(n);
+        rvv::fft::plan<T> plan(n);
+        double seconds = time_per_call([&] {
+            plan.execute(re.data(), im.data(), out_re.data(), out_im.data());
+        });
+        fout << typeid(T).name() << "\t\t"
+             << simd_t::size() << "\t\t"
+             << n << "\t\t"
+             << seconds / n * 1e9 << "\t\t"
+             << 5.0 * n * bits / seconds / 1e9 << '\n';
+    }
+}
+
 int main()
 {
     test<float>(10);
     test<double>(10);
+
+    std::ofstream fout("fft_execute.txt");
+    fout << "type\t\tsimd_len\t\tn\t\tns_per_point\t\tGFLOP/s\n";
+    test_execute<float>(fout);
+    test_execute<double>(fout);
 }
\ No newline at end of file
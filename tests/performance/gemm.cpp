@@ -0,0 +1,103 @@
+#include <rvv/rvv.hpp>
+#include <rvv/blas.hpp>
+#include <iostream>
+#include <vector>
+#include <array>
+#include <fstream>
+#include <chrono>
+
+using namespace rvv::experimental;
+
+// keeps the results of the timed calls alive
+volatile double sink = 0;
+
+// seconds per call of f, averaged over enough calls to take about 10 ms
+template <typename F>
+double time_per_call(F f)
+{
+    size_t calls = 1;
+    for (;;)
+    {
+        auto t1 = std::chrono::high_resolution_clock::now();
+        for (size_t i = 0; i < calls; i++)
+            f();
+        auto t2 = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double> diff = t2 - t1;
+        if (diff.count() > 0.01)
+            return diff.count() / calls;
+        calls *= 2;
+    }
+}
+
+// c = a * b + c with the textbook loop order
+template <typename T>
+void naive_gemm(size_t m, size_t n, size_t k, const T* a, const T* b, T* c)
+{
+    for (size_t i = 0; i < m; i++)
+        for (size_t j = 0; j < n; j++)
+        {
+            T sum = c[i * n + j];
+            for (size_t p = 0; p < k; p++)
+                sum += a[i * k + p] * b[p * n + j];
+            c[i * n + j] = sum;
+        }
+}
+
+// GFLOP/s of independent fma chains that never leave the registers, the
+// upper bound for any kernel built on simd<T>
+template <typename T>
+double peak_fma()
+{
+    constexpr size_t chains = 8;
+    constexpr size_t steps = 1024;
+    const simd<T> x(T(1.0000001)), y(T(0.9999999));
+    double seconds = time_per_call([&] {
+        std::array<simd<T>, chains> acc;
+        for (auto& v : acc)
+            v = simd<T>(T(1));
+        for (size_t s = 0; s < steps; s++)
+            for (auto& v : acc)
+                v = fma(v, x, y);
+        for (auto& v : acc)
+            sink += v[0];
+    });
+    return 2.0 * chains * steps * simd<T>::size() / seconds / 1e9;
+}
+
+template <typename T>
+void test(std::ofstream& fout)
+{
+    struct shape { size_t m, n, k; };
+    const double peak = peak_fma<T>();
+    // square, then tall, wide and thin inner dimension
+    for (shape s : {shape{64, 64, 64}, shape{256, 256, 256},
+             shape{512, 512, 512}, shape{1024, 1024, 1024},
+             shape{4096, 16, 256}, shape{16, 4096, 256},
+             shape{1024, 1024, 16}})
+    {
+        std::vector<T> a(s.m * s.k, T(1)), b(s.k * s.n, T(1)), c(s.m * s.n, T(0));
+        const double flops = 2.0 * s.m * s.n * s.k;
+        double naive = time_per_call([&] {
+            naive_gemm(s.m, s.n, s.k, a.data(), b.data(), c.data());
+            sink += c[0];
+        });
+        double blocked = time_per_call([&] {
+            rvv::blas::gemm(s.m, s.n, s.k, T(1), a.data(), s.k, b.data(),
+                s.n, T(1), c.data(), s.n);
+            sink += c[0];
+        });
+        fout << typeid(T).name() << "\t\t" << simd<T>::size() << "\t\t"
+             << s.m << "x" << s.n << "x" << s.k << "\t\t"
+             << flops / naive / 1e9 << "\t\t" << flops / blocked / 1e9 << "\t\t"
+             << peak << "\t\t" << flops / blocked / 1e9 / peak << '\n';
+    }
+}
+
+int main()
+{
+    std::ofstream fout("gemm.txt");
+    fout << "type\t\tsimd_len\t\tm x n x k\t\tnaive_GFLOP/s\t\trvv_GFLOP/s\t\t"
+            "peak_GFLOP/s\t\tfraction_of_peak\n";
+    test<float>(fout);
+    test<double>(fout);
+}
@@ -0,0 +1,65 @@
+#include <rvv/rvv.hpp>
+#include <rvv/mem.hpp>
+#include <iostream>
+#include <vector>
+#include <cstring>
+#include <fstream>
+#include <chrono>
+
+// keeps the results of the timed calls alive
+volatile size_t sink = 0;
+
+// seconds per call of f, averaged over enough calls to take about 10 ms
+template <typename F>
+double time_per_call(F f)
+{
+    size_t calls = 1;
+    for (;;)
+    {
+        auto t1 = std::chrono::high_resolution_clock::now();
+        for (size_t i = 0; i < calls; i++)
+            f();
+        auto t2 = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double> diff = t2 - t1;
+        if (diff.count() > 0.01)
+            return diff.count() / calls;
+        calls *= 2;
+    }
+}
+
+void report(std::ofstream& fout, const char* name, size_t size, double glibc, double simd)
+{
+    fout << name << "\t\t" << size << "\t\t"
+         << size / glibc / 1e9 << "\t\t" << size / simd / 1e9 << "\t\t"
+         << glibc / simd << '\n';
+}
+
+int main()
+{
+    std::ofstream fout("mem.txt");
+    fout << "function\t\tbytes\t\tglibc_GB/s\t\trvv_GB/s\t\tspeed_up\n";
+    for (size_t size : {16, 64, 256, 1024, 4096, 65536, 1 << 20, 1 << 24})
+    {
+        std::vector<char> a(size + 1, 'x'), b(size + 1, 'x');
+        // the match and the terminator are at the end
+        a[size - 1] = 'y';
+        a[size] = '\0';
+        b[size] = '\0';
+
+        report(fout, "memcpy", size,
+            time_per_call([&] { std::memcpy(b.data(), a.data(), size); sink += b[0]; }),
+            time_per_call([&] { rvv::mem::copy(b.data(), a.data(), size); sink += b[0]; }));
+        report(fout, "memset", size,
+            time_per_call([&] { std::memset(b.data(), 'x', size); sink += b[0]; }),
+            time_per_call([&] { rvv::mem::set(b.data(), 'x', size); sink += b[0]; }));
+        report(fout, "memcmp", size,
+            time_per_call([&] { sink += std::memcmp(a.data(), b.data(), size); }),
+            time_per_call([&] { sink += rvv::mem::compare(a.data(), b.data(), size); }));
+        report(fout, "memchr", size,
+            time_per_call([&] { sink += size_t(std::memchr(a.data(), 'y', size)); }),
+            time_per_call([&] { sink += size_t(rvv::mem::find(a.data(), 'y', size)); }));
+        report(fout, "strlen", size,
+            time_per_call([&] { sink += std::strlen(a.data()); }),
+            time_per_call([&] { sink += rvv::mem::strlen(a.data()); }));
+    }
+}
@@ -0,0 +1,226 @@
+#include <rvv/rvv.hpp>
+#include <rvv/algorithms.hpp>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <span>
+#include <cstdlib>
+#include <ctime>
+
+
+bool test_true(bool x){
+    if(!x){
+        std::cout << "Test failed!" << std::endl;
+    }
+    return x;
+}
+
+template <typename T>
+std::vector<T> random_vector(size_t size){
+    std::vector<T> v(size);
+    for(auto& x : v)
+        x = T(std::rand() % 100);
+    return v;
+}
+
+// sizes around multiples of the simd size and of the unrolled main loop
+template <typename T>
+std::vector<size_t> test_sizes(){
+    const size_t lanes = rvv::experimental::simd<T>::size();
+    return {0, 1, lanes - 1, lanes, lanes + 1, 2 * lanes + 3, 4 * lanes,
+        4 * lanes + 1, 5 * lanes - 1, 8 * lanes, 9 * lanes + 2, 17 * lanes + 5, 1000};
+}
+
+template <typename T>
+bool test(){
+    bool success = true;
+    using namespace rvv::experimental;
+    namespace alg = rvv::algorithms;
+
+    std::cout << "fill, copy" << std::endl;
+    for(size_t size : test_sizes<T>()){
+        // the guard element behind the range stays untouched
+        std::vector<T> a(size + 1, T(7)), b(size + 1, T(9));
+        alg::fill(std::span(a.data(), size), T(3));
+        bool ok = std::all_of(a.begin(), a.end() - 1, [](T x){ return x == T(3); }) && a.back() == T(7);
+        alg::copy(std::span(a.data(), size), b);
+        ok &= std::equal(a.begin(), a.end() - 1, b.begin()) && b.back() == T(9);
+        success &= test_true(ok);
+    }
+
+    std::cout << "transform" << std::endl;
+    for(size_t size : test_sizes<T>()){
+        auto a = random_vector<T>(size), b = random_vector<T>(size);
+        std::vector<T> out(size + 1, T(5));
+        alg::transform(a, std::span(out.data(), size), [](simd<T> x){ return x * x + T(1); });
+        bool ok = out.back() == T(5);
+        for(size_t i = 0; i < size; i++)
+            ok &= out[i] == T(a[i] * a[i] + T(1));
+        alg::transform(a, b, std::span(out.data(), size), [](simd<T> x, simd<T> y){ return x + y * T(2); });
+        for(size_t i = 0; i < size; i++)
+            ok &= out[i] == T(a[i] + b[i] * T(2));
+        success &= test_true(ok && out.back() == T(5));
+    }
+
+    std::cout << "for_each, generate" << std::endl;
+    for(size_t size : test_sizes<T>()){
+        auto a = random_vector<T>(size);
+        auto original = a;
+        alg::for_each(a, [](simd<T>& x){ x += T(4); });
+        bool ok = true;
+        for(size_t i = 0; i < size; i++)
+            ok &= a[i] == T(original[i] + T(4));
+        std::vector<T> g(size + 1, T(1));
+        alg::generate(std::span(g.data(), size), [](size_t i){
+            return simd<T>(simd<T>::index0123) + T(i % 64);
+        });
+        const size_t lanes = simd<T>::size();
+        for(size_t i = 0; i < size; i++)
+            ok &= g[i] == T(i % lanes + (i - i % lanes) % 64);
+        success &= test_true(ok && g.back() == T(1));
+    }
+
+    std::cout << "copy_if, remove_if, partition_copy, partition" << std::endl;
+    for(size_t size : test_sizes<T>()){
+        auto a = random_vector<T>(size);
+        auto pred = [](simd<T> x){ return x < T(40); };
+        auto scalar_pred = [](T x){ return x < T(40); };
+        std::vector<T> expected_true, expected_false;
+        std::copy_if(a.begin(), a.end(), std::back_inserter(expected_true), scalar_pred);
+        std::remove_copy_if(a.begin(), a.end(), std::back_inserter(expected_false), scalar_pred);
+
+        std::vector<T> out(size + 1, T(99)), out2(size + 1, T(99));
+        size_t count = alg::copy_if(a, out, pred);
+        bool ok = count == expected_true.size() && std::equal(expected_true.begin(), expected_true.end(), out.begin());
+
+        auto removed = a;
+        count = alg::remove_if(removed, pred);
+        ok &= count == expected_false.size() && std::equal(expected_false.begin(), expected_false.end(), removed.begin());
+
+        auto [count_true, count_false] = alg::partition_copy(a, out, out2, pred);
+        ok &= count_true == expected_true.size() && count_false == expected_false.size();
+        ok &= std::equal(expected_true.begin(), expected_true.end(), out.begin());
+        ok &= std::equal(expected_false.begin(), expected_false.end(), out2.begin());
+        ok &= out[size] == T(99) && out2[size] == T(99);
+
+        // same elements, the order within the parts may change
+        auto partitioned = a;
+        count = alg::partition(partitioned, pred);
+        ok &= count == expected_true.size();
+        ok &= std::all_of(partitioned.begin(), partitioned.begin() + count, scalar_pred);
+        ok &= std::none_of(partitioned.begin() + count, partitioned.end(), scalar_pred);
+        std::sort(partitioned.begin(), partitioned.end());
+        auto sorted = a;
+        std::sort(sorted.begin(), sorted.end());
+        ok &= partitioned == sorted;
+        if(!ok)
+            std::cout << "mismatch for size " << size << std::endl;
+        success &= test_true(ok);
+    }
+
+    std::cout << "find, count, mismatch" << std::endl;
+    for(size_t size : test_sizes<T>()){
+        auto a = random_vector<T>(size);
+        bool ok = true;
+        for(T value : {T(0), T(42), T(99), T(100)}){
+            size_t expected = std::find(a.begin(), a.end(), value) - a.begin();
+            ok &= alg::find(a, value) == expected;
+            ok &= alg::count(a, value) == size_t(std::count(a.begin(), a.end(), value));
+        }
+        auto scalar_pred = [](T x){ return x > T(90); };
+        ok &= alg::find_if(a, [](simd<T> x){ return x > T(90); }) ==
+            size_t(std::find_if(a.begin(), a.end(), scalar_pred) - a.begin());
+        ok &= alg::count_if(a, [](simd<T> x){ return x > T(90); }) ==
+            size_t(std::count_if(a.begin(), a.end(), scalar_pred));
+
+        auto b = a;
+        ok &= alg::mismatch(a, b) == size;
+        ok &= alg::mismatch(a, std::span(b.data(), size / 2)) == size / 2;
+        for(size_t i : {size - 1, size / 3, size_t(0)}){
+            if(i >= size)
+                continue;
+            b[i] = T(b[i] + T(1));
+            ok &= alg::mismatch(a, b) == i;
+        }
+        if(!ok)
+            std::cout << "mismatch for size " << size << std::endl;
+        success &= test_true(ok);
+    }
+
+    if constexpr (sizeof(T) >= 4){
+        using I = rvv_impl::index_of<T>;
+        std::cout << "lower_bound_many" << std::endl;
+        for(size_t size : test_sizes<T>()){
+            auto sorted = random_vector<T>(size);
+            std::sort(sorted.begin(), sorted.end());
+            auto queries = random_vector<T>(size + 7);
+            queries[0] = T(0);
+            queries[1] = T(100);
+            std::vector<I> out(queries.size() + 1, I(12345));
+            alg::lower_bound_many(sorted, queries, std::span(out.data(), queries.size()));
+            bool ok = out.back() == I(12345);
+            for(size_t j = 0; j < queries.size(); j++)
+                ok &= out[j] == I(std::lower_bound(sorted.begin(), sorted.end(), queries[j]) - sorted.begin());
+            if(!ok)
+                std::cout << "mismatch for size " << size << std::endl;
+            success &= test_true(ok);
+        }
+    }
+
+    std::cout << "transform_reduce" << std::endl;
+    for(size_t size : test_sizes<T>()){
+        auto a = random_vector<T>(size);
+        T sum = alg::transform_reduce(a, T(10), std::plus<>{}, [](simd<T> x){ return x * T(2); });
+        T expected = T(10);
+        for(auto x : a)
+            expected = T(expected + T(x * T(2)));
+        bool ok = sum == expected;
+        T largest = alg::transform_reduce(a, T(0),
+            [](simd<T> x, simd<T> y){ return max(x, y); }, [](simd<T> x){ return x; });
+        ok &= largest == (size ? std::max(T(0), *std::max_element(a.begin(), a.end())) : T(0));
+        if(!ok)
+            std::cout << "mismatch for size " << size << std::endl;
+        success &= test_true(ok);
+    }
+
+    std::cout << "reduce" << std::endl;
+    for(size_t size : test_sizes<T>()){
+        auto a = random_vector<T>(size);
+        T expected = T(1);
+        for(auto x : a)
+            expected = T(expected + x);
+        bool ok = rvv::reduce(a.begin(), a.end(), T(1)) == expected;
+        ok &= rvv::reduce(a, T(1), std::plus<>{}) == expected;
+        T smallest = rvv::reduce(a.data(), a.data() + size, T(100),
+            [](simd<T> x, simd<T> y){ return min(x, y); });
+        ok &= smallest == (size ? std::min(T(100), *std::min_element(a.begin(), a.end())) : T(100));
+        if(!ok)
+            std::cout << "mismatch for size " << size << std::endl;
+        success &= test_true(ok);
+    }
+    return success;
+}
+
+
+int main(){
+    std::srand(std::time(nullptr));
+
+    bool success = true;
+
+    std::cout << "Testing float" << std::endl;
+    success &= test<float>();
+    std::cout << "Testing double" << std::endl;
+    success &= test<double>();
+    std::cout << "Testing int8_t" << std::endl;
+    success &= test<int8_t>();
+    std::cout << "Testing uint16_t" << std::endl;
+    success &= test<uint16_t>();
+    std::cout << "Testing int32_t" << std::endl;
+    success &= test<int32_t>();
+    std::cout << "Testing uint64_t" << std::endl;
+    success &= test<uint64_t>();
+
+    return success ? 0 : -1;
+}
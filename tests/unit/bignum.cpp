@@ -0,0 +1,211 @@
+#include <rvv/rvv.hpp>
+#include <rvv/bignum.hpp>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
+
+
+bool test_true(bool x){
+    if(!x){
+        std::cout << "Test failed!" << std::endl;
+    }
+    return x;
+}
+
+template <typename T>
+T random_limb(){
+    uint64_t bits = (uint64_t(std::rand()) << 42) ^ (uint64_t(std::rand()) << 21) ^ uint64_t(std::rand());
+    return T(bits);
+}
+
+// Scalar references on one number, limbs least significant first
+template <typename T>
+using number = std::vector<T>;
+
+using wide = unsigned __int128;
+
+template <typename T>
+T add_reference(number<T>& r, const number<T>& a, const number<T>& b){
+    wide carry = 0;
+    for(size_t i = 0; i < a.size(); i++){
+        wide s = wide(a[i]) + b[i] + carry;
+        r[i] = T(s);
+        carry = s >> (8 * sizeof(T));
+    }
+    return T(carry);
+}
+
+template <typename T>
+T sub_reference(number<T>& r, const number<T>& a, const number<T>& b){
+    T borrow = 0;
+    for(size_t i = 0; i < a.size(); i++){
+        wide d = wide(a[i]) - b[i] - borrow;
+        r[i] = T(d);
+        borrow = T(d >> (8 * sizeof(T))) & 1;
+    }
+    return borrow;
+}
+
+template <typename T>
+bool less_than(const number<T>& a, const number<T>& b){
+    return std::lexicographical_compare(a.rbegin(), a.rend(), b.rbegin(), b.rend());
+}
+
+template <typename T>
+number<T> multiply_reference(const number<T>& a, const number<T>& b){
+    number<T> r(a.size() + b.size(), 0);
+    for(size_t i = 0; i < b.size(); i++){
+        wide carry = 0;
+        for(size_t k = 0; k < a.size(); k++){
+            wide t = wide(r[i + k]) + wide(a[k]) * b[i] + carry;
+            r[i + k] = T(t);
+            carry = t >> (8 * sizeof(T));
+        }
+        r[i + a.size()] = T(carry);
+    }
+    return r;
+}
+
+// a * b * 2^(-w * limbs) mod m by halving the product modulo m bit by bit
+template <typename T>
+number<T> montgomery_reference(const number<T>& a, const number<T>& b, const number<T>& m){
+    number<T> t = multiply_reference(a, b);
+    number<T> m_wide(m);
+    m_wide.resize(t.size() + 1, 0);
+    t.push_back(0);
+    for(size_t bit = 0; bit < 8 * sizeof(T) * m.size(); bit++){
+        if(t[0] & 1)
+            add_reference(t, number<T>(t), m_wide);
+        for(size_t i = 0; i + 1 < t.size(); i++)
+            t[i] = T((t[i] >> 1) | (t[i + 1] << (8 * sizeof(T) - 1)));
+        t.back() >>= 1;
+    }
+    t.resize(m.size() + 1);
+    number<T> r(m.size());
+    std::copy(t.begin(), t.begin() + m.size(), r.begin());
+    if(t.back() || !less_than(r, m))
+        sub_reference(r, number<T>(r), m);
+    return r;
+}
+
+template <typename T, size_t Limbs>
+bool test(){
+    bool success = true;
+    const size_t lanes = rvv::experimental::simd<T>::size();
+    const size_t count = 3 * lanes + 1;
+
+    // limb major batches
+    std::vector<T> a(Limbs * count), b(Limbs * count), r(2 * Limbs * count), flags(count);
+    std::vector<number<T>> na(count, number<T>(Limbs)), nb(count, number<T>(Limbs));
+    auto get = [&](const std::vector<T>& batch, size_t j, size_t limbs){
+        number<T> n(limbs);
+        for(size_t i = 0; i < limbs; i++)
+            n[i] = batch[i * count + j];
+        return n;
+    };
+
+    // an odd modulus with the top bit set, a and b below it
+    number<T> m(Limbs);
+    std::generate(m.begin(), m.end(), random_limb<T>);
+    m[0] |= 1;
+    m[Limbs - 1] |= T(1) << (8 * sizeof(T) - 1);
+    for(size_t j = 0; j < count; j++){
+        for(size_t i = 0; i < Limbs; i++){
+            a[i * count + j] = random_limb<T>();
+            b[i * count + j] = random_limb<T>();
+        }
+        a[(Limbs - 1) * count + j] %= m[Limbs - 1];
+        b[(Limbs - 1) * count + j] %= m[Limbs - 1];
+        na[j] = get(a, j, Limbs);
+        nb[j] = get(b, j, Limbs);
+    }
+    // carries all the way through
+    for(size_t i = 0; i < Limbs; i++){
+        a[i * count] = T(~T(0));
+        b[i * count] = T(i == 0);
+    }
+    na[0] = get(a, 0, Limbs);
+    nb[0] = get(b, 0, Limbs);
+
+    std::cout << "add" << std::endl;
+    rvv::bignum::add<Limbs>(a.data(), b.data(), r.data(), count, flags.data());
+    bool ok = true;
+    for(size_t j = 0; j < count; j++){
+        number<T> expected(Limbs);
+        T carry = add_reference(expected, na[j], nb[j]);
+        ok &= get(r, j, Limbs) == expected && flags[j] == carry;
+    }
+    success &= test_true(ok);
+
+    std::cout << "sub" << std::endl;
+    rvv::bignum::sub<Limbs>(b.data(), a.data(), r.data(), count, flags.data());
+    ok = true;
+    for(size_t j = 0; j < count; j++){
+        number<T> expected(Limbs);
+        T borrow = sub_reference(expected, nb[j], na[j]);
+        ok &= get(r, j, Limbs) == expected && flags[j] == borrow;
+    }
+    success &= test_true(ok);
+
+    std::cout << "multiply" << std::endl;
+    rvv::bignum::multiply<Limbs>(a.data(), b.data(), r.data(), count);
+    ok = true;
+    for(size_t j = 0; j < count; j++)
+        ok &= get(r, j, 2 * Limbs) == multiply_reference(na[j], nb[j]);
+    success &= test_true(ok);
+
+    // the first number is all ones, keep everything below m from here on
+    for(size_t i = 0; i < Limbs; i++)
+        a[i * count] = m[i] - (i == 0);
+    na[0] = get(a, 0, Limbs);
+
+    std::cout << "add_mod, sub_mod" << std::endl;
+    rvv::bignum::add_mod<Limbs>(a.data(), b.data(), m.data(), r.data(), count);
+    ok = true;
+    for(size_t j = 0; j < count; j++){
+        number<T> expected(Limbs);
+        T carry = add_reference(expected, na[j], nb[j]);
+        if(carry || !less_than(expected, m))
+            sub_reference(expected, number<T>(expected), m);
+        ok &= get(r, j, Limbs) == expected;
+    }
+    rvv::bignum::sub_mod<Limbs>(b.data(), a.data(), m.data(), r.data(), count);
+    for(size_t j = 0; j < count; j++){
+        number<T> expected(Limbs);
+        if(sub_reference(expected, nb[j], na[j]))
+            add_reference(expected, number<T>(expected), m);
+        ok &= get(r, j, Limbs) == expected;
+    }
+    success &= test_true(ok);
+
+    std::cout << "montgomery_multiply" << std::endl;
+    const T factor = rvv::bignum::montgomery_factor(m[0]);
+    success &= test_true(T(factor * m[0]) == T(~T(0)));
+    rvv::bignum::montgomery_multiply<Limbs>(a.data(), b.data(), m.data(), factor, r.data(), count);
+    ok = true;
+    for(size_t j = 0; j < count; j++)
+        ok &= get(r, j, Limbs) == montgomery_reference(na[j], nb[j], m);
+    success &= test_true(ok);
+
+    return success;
+}
+
+
+int main(){
+    std::srand(std::time(nullptr));
+
+    bool success = true;
+
+    std::cout << "Testing 8 x uint32_t" << std::endl;
+    success &= test<uint32_t, 8>();
+    std::cout << "Testing 4 x uint64_t" << std::endl;
+    success &= test<uint64_t, 4>();
+    std::cout << "Testing 1 x uint64_t" << std::endl;
+    success &= test<uint64_t, 1>();
+    std::cout << "Testing 17 x uint32_t" << std::endl;
+    success &= test<uint32_t, 17>();
+
+    return success ? 0 : -1;
+}
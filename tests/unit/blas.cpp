@@ -0,0 +1,176 @@
+#include <rvv/rvv.hpp>
+#include <rvv/blas.hpp>
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <cstdlib>
+#include <ctime>
+
+
+bool test_true(bool x){
+    if(!x){
+        std::cout << "Test failed!" << std::endl;
+    }
+    return x;
+}
+
+template <typename T>
+std::vector<T> random_vector(size_t size){
+    std::vector<T> v(size);
+    for(auto& x : v)
+        x = T(std::rand() % 200 - 100) / T(32);
+    return v;
+}
+
+template <typename T>
+bool approximately_equal(const std::vector<T>& x, const std::vector<T>& y, T tolerance){
+    for(size_t i = 0; i < x.size(); i++)
+        if(!(std::abs(x[i] - y[i]) <= tolerance * (T(1) + std::abs(y[i]))))
+            return false;
+    return true;
+}
+
+// offset of element i of a vector of n elements, as in the reference BLAS
+size_t element(size_t i, size_t n, ptrdiff_t inc){
+    return inc < 0 ? (n - 1 - i) * size_t(-inc) : i * size_t(inc);
+}
+
+bool approximately_equal(double x, double y, double tolerance){
+    return std::abs(x - y) <= tolerance * (1 + std::abs(y));
+}
+
+template <typename T>
+bool test(){
+    bool success = true;
+    const T tolerance = std::is_same_v<T, float> ? T(1e-4) : T(1e-10);
+    const size_t lanes = rvv::experimental::simd<T>::size();
+
+    std::cout << "axpy, scal, dot, asum, nrm2, iamax" << std::endl;
+    for(size_t n : {size_t(0), size_t(1), lanes - 1, lanes + 1, 9 * lanes + 3, size_t(1000)}){
+        for(ptrdiff_t inc : {ptrdiff_t(1), ptrdiff_t(3), ptrdiff_t(-1), ptrdiff_t(-2)}){
+            const size_t span = n ? (n - 1) * size_t(std::abs(inc)) + 1 : 0;
+            auto x = random_vector<T>(span);
+            auto y = random_vector<T>(n);
+            bool ok = true;
+
+            auto expected = y;
+            for(size_t i = 0; i < n; i++)
+                expected[i] = T(2.5) * x[element(i, n, inc)] + y[i];
+            auto result = y;
+            rvv::blas::axpy(n, T(2.5), x.data(), inc, result.data(), 1);
+            ok &= approximately_equal(result, expected, tolerance);
+
+            auto scaled = x;
+            rvv::blas::scal(n, T(-3), scaled.data(), inc);
+            for(size_t i = 0; i < span; i++)
+                ok &= scaled[i] == ((i % std::abs(inc)) ? x[i] : T(-3) * x[i]);
+
+            double dot = 0, asum = 0, squares = 0;
+            size_t iamax = 0;
+            for(size_t i = 0; i < n; i++){
+                T v = x[element(i, n, inc)];
+                dot += double(v) * double(y[n - 1 - i]);
+                asum += std::abs(v);
+                squares += double(v) * double(v);
+                if(std::abs(v) > std::abs(x[element(iamax, n, inc)]))
+                    iamax = i;
+            }
+            // y walked backwards with a negative unit increment
+            ok &= approximately_equal(rvv::blas::dot(n, x.data(), inc, y.data(), -1), dot, tolerance);
+            ok &= approximately_equal(rvv::blas::asum(n, x.data(), inc), asum, tolerance);
+            ok &= approximately_equal(rvv::blas::nrm2(n, x.data(), inc), std::sqrt(squares), tolerance);
+            ok &= rvv::blas::iamax(n, x.data(), inc) == iamax;
+
+            // squares out of the range of T
+            for(T magnitude : {std::numeric_limits<T>::max() / T(64), std::numeric_limits<T>::min() * T(4)}){
+                std::vector<T> big(span, magnitude);
+                T norm = rvv::blas::nrm2(n, big.data(), inc);
+                ok &= approximately_equal(norm, magnitude * std::sqrt(T(n)), tolerance);
+            }
+            if(!ok)
+                std::cout << "mismatch for n " << n << " inc " << inc << std::endl;
+            success &= test_true(ok);
+        }
+    }
+
+    std::cout << "gemv, ger" << std::endl;
+    for(size_t m : {size_t(1), size_t(6), size_t(37)}){
+        for(size_t n : {size_t(1), lanes + 2, size_t(150)}){
+            for(ptrdiff_t inc : {ptrdiff_t(1), ptrdiff_t(-2)}){
+                const size_t lda = n + 1;
+                auto a = random_vector<T>(m * lda);
+                auto x = random_vector<T>((n - 1) * size_t(std::abs(inc)) + 1);
+                auto y = random_vector<T>(m);
+                std::vector<T> expected(m);
+                for(size_t i = 0; i < m; i++){
+                    T sum = T(0);
+                    for(size_t j = 0; j < n; j++)
+                        sum += a[i * lda + j] * x[element(j, n, inc)];
+                    expected[i] = T(2) * sum + T(0.5) * y[i];
+                }
+                rvv::blas::gemv(m, n, T(2), a.data(), lda, x.data(), inc, T(0.5), y.data(), 1);
+                bool ok = approximately_equal(y, expected, tolerance);
+
+                std::vector<T> u = random_vector<T>(m), v = random_vector<T>(n);
+                auto outer = a;
+                for(size_t i = 0; i < m; i++)
+                    for(size_t j = 0; j < n; j++)
+                        outer[i * lda + j] += T(-1.5) * u[i] * v[j];
+                rvv::blas::ger(m, n, T(-1.5), u.data(), 1, v.data(), 1, a.data(), lda);
+                ok &= approximately_equal(a, outer, tolerance);
+                if(!ok)
+                    std::cout << "mismatch for " << m << "x" << n << " inc " << inc << std::endl;
+                success &= test_true(ok);
+            }
+        }
+    }
+
+    std::cout << "gemm" << std::endl;
+    struct shape { size_t m, n, k; };
+    // edges of the micro-kernel and of the cache blocks
+    for(shape s : {shape{1, 1, 1}, shape{3, 5, 2}, shape{8, 16, 7}, shape{17, 33, 19},
+                   shape{130, 70, 300}, shape{9, 2100, 3}}){
+        for(T beta : {T(0), T(1), T(-0.5)}){
+            const T alpha = T(1.5);
+            // padded leading dimensions
+            const size_t lda = s.k + 1, ldb = s.n + 3, ldc = s.n + 2;
+            auto a = random_vector<T>(s.m * lda);
+            auto b = random_vector<T>(s.k * ldb);
+            auto c = random_vector<T>(s.m * ldc);
+            auto expected = c;
+            if(beta == T(0))
+                for(size_t i = 0; i < s.m; i++)
+                    for(size_t j = 0; j < s.n; j++)
+                        c[i * ldc + j] = std::numeric_limits<T>::quiet_NaN();
+            for(size_t i = 0; i < s.m; i++){
+                for(size_t j = 0; j < s.n; j++){
+                    T sum = T(0);
+                    for(size_t p = 0; p < s.k; p++)
+                        sum += a[i * lda + p] * b[p * ldb + j];
+                    expected[i * ldc + j] = alpha * sum + (beta == T(0) ? T(0) : beta * expected[i * ldc + j]);
+                }
+            }
+            rvv::blas::gemm(s.m, s.n, s.k, alpha, a.data(), lda, b.data(), ldb, beta, c.data(), ldc);
+            bool ok = approximately_equal(c, expected, tolerance);
+            if(!ok)
+                std::cout << "mismatch for " << s.m << "x" << s.n << "x" << s.k << " beta " << beta << std::endl;
+            success &= test_true(ok);
+        }
+    }
+    return success;
+}
+
+
+int main(){
+    std::srand(std::time(nullptr));
+
+    bool success = true;
+
+    std::cout << "Testing float" << std::endl;
+    success &= test<float>();
+    std::cout << "Testing double" << std::endl;
+    success &= test<double>();
+
+    return success ? 0 : -1;
+}
@@ -0,0 +1,147 @@
+#include <rvv/rvv.hpp>
+#include <rvv/checksum.hpp>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+
+bool test_true(bool x){
+    if(!x){
+        std::cout << "Test failed!" << std::endl;
+    }
+    return x;
+}
+
+// bit at a time references, straight from the definitions
+uint32_t crc_reference(uint32_t polynomial, const uint8_t* p, size_t size, uint32_t crc = 0){
+    crc = ~crc;
+    for(size_t i = 0; i < size; i++){
+        crc ^= p[i];
+        for(int k = 0; k < 8; k++)
+            crc = (crc >> 1) ^ ((crc & 1) ? polynomial : 0);
+    }
+    return ~crc;
+}
+
+// GCM specification, algorithm 1 (bits numbered from the most significant)
+void gf128_multiply_reference(const uint8_t* x, const uint8_t* y, uint8_t* out){
+    uint8_t z[16] = {}, v[16];
+    std::memcpy(v, y, 16);
+    for(int i = 0; i < 128; i++){
+        if((x[i / 8] >> (7 - i % 8)) & 1)
+            for(int j = 0; j < 16; j++) z[j] ^= v[j];
+        bool lsb = v[15] & 1;
+        for(int j = 15; j > 0; j--) v[j] = uint8_t((v[j] >> 1) | (v[j - 1] << 7));
+        v[0] >>= 1;
+        if(lsb) v[0] ^= 0xe1;
+    }
+    std::memcpy(out, z, 16);
+}
+
+void ghash_reference(const uint8_t* h, const uint8_t* data, size_t size, uint8_t* y){
+    for(size_t i = 0; i < size; i += 16){
+        uint8_t block[16] = {};
+        std::memcpy(block, data + i, std::min<size_t>(16, size - i));
+        for(int j = 0; j < 16; j++) y[j] ^= block[j];
+        gf128_multiply_reference(y, h, y);
+    }
+}
+
+uint64_t random_u64(){
+    return (uint64_t(std::rand()) << 42) ^ (uint64_t(std::rand()) << 21) ^ uint64_t(std::rand());
+}
+
+bool test_clmul(){
+    bool success = true;
+    using namespace rvv::experimental;
+    const int simd_size = simd<uint64_t>::size();
+
+    std::vector<uint64_t> a(simd_size), b(simd_size);
+    std::generate(a.begin(), a.end(), random_u64);
+    std::generate(b.begin(), b.end(), random_u64);
+    a[0] = ~uint64_t(0);
+    b[0] = ~uint64_t(0);
+    simd<uint64_t> x(a.data(), vector_aligned);
+    simd<uint64_t> y(b.data(), vector_aligned);
+    simd<uint64_t> lo = clmul(x, y);
+    simd<uint64_t> hi = clmulh(x, y);
+
+    std::cout << "clmul, clmulh" << std::endl;
+    for(int i = 0; i < simd_size; i++){
+        uint64_t ref_lo = 0, ref_hi = 0;
+        for(int k = 0; k < 64; k++){
+            if((b[i] >> k) & 1){
+                ref_lo ^= a[i] << k;
+                if(k) ref_hi ^= a[i] >> (64 - k);
+            }
+        }
+        success &= test_true(lo[i] == ref_lo && hi[i] == ref_hi);
+    }
+    return success;
+}
+
+bool test_crc(){
+    bool success = true;
+
+    std::cout << "crc32, crc32c check values" << std::endl;
+    const char* check = "123456789";
+    success &= test_true(rvv::crc32(check, 9) == 0xcbf43926);
+    success &= test_true(rvv::crc32c(check, 9) == 0xe3069283);
+    success &= test_true(rvv::crc32(check, 0) == 0);
+
+    std::cout << "crc32, crc32c random buffers" << std::endl;
+    std::vector<uint8_t> data(5000);
+    std::generate(data.begin(), data.end(), [](){ return uint8_t(std::rand()); });
+    for(size_t size : {1, 7, 8, 31, 64, 255, 256, 1000, 4093}){
+        size_t offset = std::rand() % 7;
+        const uint8_t* p = data.data() + offset;
+        bool ok = rvv::crc32(p, size) == crc_reference(0xedb88320, p, size);
+        ok &= rvv::crc32c(p, size) == crc_reference(0x82f63b78, p, size);
+        // continuing a checksum gives the same result as one pass
+        size_t split = size / 3;
+        ok &= rvv::crc32(p + split, size - split, rvv::crc32(p, split)) == rvv::crc32(p, size);
+        ok &= rvv::crc32c(p + split, size - split, rvv::crc32c(p, split)) == rvv::crc32c(p, size);
+        if(!ok)
+            std::cout << "mismatch for size " << size << std::endl;
+        success &= test_true(ok);
+    }
+    return success;
+}
+
+bool test_ghash(){
+    bool success = true;
+    std::cout << "ghash" << std::endl;
+
+    std::vector<uint8_t> data(3000);
+    std::generate(data.begin(), data.end(), [](){ return uint8_t(std::rand()); });
+    for(size_t size : {0, 5, 16, 100, 256, 1024, 2999}){
+        uint8_t h[16], y[16], y_ref[16];
+        for(int i = 0; i < 16; i++){
+            h[i] = uint8_t(std::rand());
+            y[i] = y_ref[i] = uint8_t(std::rand());
+        }
+        const uint8_t* p = data.data() + std::rand() % 7;
+        rvv::ghash(h, p, size, y);
+        ghash_reference(h, p, size, y_ref);
+        bool ok = std::equal(y, y + 16, y_ref);
+        if(!ok)
+            std::cout << "mismatch for size " << size << std::endl;
+        success &= test_true(ok);
+    }
+    return success;
+}
+
+
+int main(){
+    std::srand(std::time(nullptr));
+
+    bool success = true;
+    success &= test_clmul();
+    success &= test_crc();
+    success &= test_ghash();
+
+    return success ? 0 : -1;
+}
@@ -0,0 +1,221 @@
+#include <rvv/rvv.hpp>
+#include <rvv/crypto.hpp>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+
+bool test_true(bool x){
+    if(!x){
+        std::cout << "Test failed!" << std::endl;
+    }
+    return x;
+}
+
+std::vector<uint8_t> from_hex(const std::string& hex){
+    std::vector<uint8_t> bytes(hex.size() / 2);
+    for(size_t i = 0; i < bytes.size(); i++)
+        bytes[i] = uint8_t(std::stoul(hex.substr(2 * i, 2), nullptr, 16));
+    return bytes;
+}
+
+std::vector<uint8_t> random_bytes(size_t size){
+    std::vector<uint8_t> data(size);
+    std::generate(data.begin(), data.end(), [](){ return uint8_t(std::rand()); });
+    return data;
+}
+
+bool test_aes(){
+    bool success = true;
+    using namespace rvv::crypto;
+
+    // FIPS-197 appendix C
+    std::cout << "aes128, aes256 known answers" << std::endl;
+    const auto plaintext = from_hex("00112233445566778899aabbccddeeff");
+    {
+    auto key = aes128_expand_key(from_hex("000102030405060708090a0b0c0d0e0f").data());
+    uint8_t out[16], back[16];
+    aes_encrypt(key, plaintext.data(), out, 1);
+    success &= test_true(std::equal(out, out + 16, from_hex("69c4e0d86a7b0430d8cdb78070b4c55a").begin()));
+    aes_decrypt(key, out, back, 1);
+    success &= test_true(std::equal(back, back + 16, plaintext.begin()));
+    }
+    {
+    auto key = aes256_expand_key(from_hex("000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f").data());
+    uint8_t out[16], back[16];
+    aes_encrypt(key, plaintext.data(), out, 1);
+    success &= test_true(std::equal(out, out + 16, from_hex("8ea2b7ca516745bfeafc49904b496089").begin()));
+    aes_decrypt(key, out, back, 1);
+    success &= test_true(std::equal(back, back + 16, plaintext.begin()));
+    }
+
+    std::cout << "aes bulk blocks" << std::endl;
+    for(size_t blocks : {1, 2, 3, 7, 16, 33}){
+        auto key = aes128_expand_key(random_bytes(16).data());
+        auto data = random_bytes(16 * blocks);
+        std::vector<uint8_t> out(data.size()), back(data.size());
+        aes_encrypt(key, data.data(), out.data(), blocks);
+        // every block is encrypted on its own
+        bool ok = true;
+        for(size_t i = 0; i < blocks; i++){
+            uint8_t single[16];
+            aes_encrypt(key, data.data() + 16 * i, single, 1);
+            ok &= std::equal(single, single + 16, out.begin() + 16 * i);
+        }
+        aes_decrypt(key, out.data(), back.data(), blocks);
+        ok &= back == data;
+        if(!ok)
+            std::cout << "mismatch for " << blocks << " blocks" << std::endl;
+        success &= test_true(ok);
+    }
+    return success;
+}
+
+bool test_aes_ctr(){
+    bool success = true;
+    using namespace rvv::crypto;
+
+    // SP 800-38A F.5.1 and F.5.5
+    std::cout << "aes_ctr known answers" << std::endl;
+    const auto plaintext = from_hex(
+        "6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e51"
+        "30c81c46a35ce411e5fbc1191a0a52eff69f2445df4f9b17ad2b417be66c3710");
+    const auto initial_counter = from_hex("f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff");
+    {
+    auto key = aes128_expand_key(from_hex("2b7e151628aed2a6abf7158809cf4f3c").data());
+    auto expected = from_hex(
+        "874d6191b620e3261bef6864990db6ce9806f66b7970fdff8617187bb9fffdff"
+        "5ae4df3edbd5d35e5b4f09020db03eab1e031dda2fbe03d1792170a0f3009cee");
+    std::vector<uint8_t> out(64);
+    uint8_t counter[16];
+    std::memcpy(counter, initial_counter.data(), 16);
+    aes_ctr(key, counter, plaintext.data(), out.data(), 64);
+    success &= test_true(out == expected);
+    // the carry out of the last byte reaches the one before it
+    success &= test_true(counter[15] == 0x03 && counter[14] == 0xff && counter[0] == 0xf0);
+    }
+    {
+    auto key = aes256_expand_key(from_hex(
+        "603deb1015ca71be2b73aef0857d77811f352c073b6108d72d9810a30914dff4").data());
+    auto expected = from_hex(
+        "601ec313775789a5b7a7f504bbf3d228f443e3ca4d62b59aca84e990cacaf5c5"
+        "2b0930daa23de94ce87017ba2d84988ddfc9c58db67aada613c2dd08457941a6");
+    std::vector<uint8_t> out(64);
+    uint8_t counter[16];
+    std::memcpy(counter, initial_counter.data(), 16);
+    aes_ctr(key, counter, plaintext.data(), out.data(), 64);
+    success &= test_true(out == expected);
+    }
+
+    std::cout << "aes_ctr random buffers" << std::endl;
+    for(size_t size : {1, 15, 16, 100, 256, 1000, 4099}){
+        auto key = aes256_expand_key(random_bytes(32).data());
+        auto iv = random_bytes(16);
+        auto data = random_bytes(size);
+        std::vector<uint8_t> out(size), out_split(size), back(size);
+        uint8_t counter[16];
+        std::memcpy(counter, iv.data(), 16);
+        aes_ctr(key, counter, data.data(), out.data(), size);
+        // continuing at a block boundary gives the same stream
+        size_t split = (size / 3) & ~size_t(15);
+        std::memcpy(counter, iv.data(), 16);
+        aes_ctr(key, counter, data.data(), out_split.data(), split);
+        aes_ctr(key, counter, data.data() + split, out_split.data() + split, size - split);
+        std::memcpy(counter, iv.data(), 16);
+        aes_ctr(key, counter, out.data(), back.data(), size);
+        bool ok = out == out_split && back == data;
+        if(!ok)
+            std::cout << "mismatch for size " << size << std::endl;
+        success &= test_true(ok);
+    }
+    return success;
+}
+
+bool test_sha2(){
+    bool success = true;
+    using namespace rvv::crypto;
+
+    // FIPS-180 examples and a longer message of (31 i + 7) mod 256 bytes
+    std::cout << "sha256, sha512 known answers" << std::endl;
+    std::vector<uint8_t> long_message(1000);
+    for(size_t i = 0; i < long_message.size(); i++)
+        long_message[i] = uint8_t(i * 31 + 7);
+    const std::string two_blocks = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    {
+    uint8_t digest[32];
+    sha256("abc", 3, digest);
+    success &= test_true(std::equal(digest, digest + 32, from_hex(
+        "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad").begin()));
+    sha256("", 0, digest);
+    success &= test_true(std::equal(digest, digest + 32, from_hex(
+        "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855").begin()));
+    sha256(two_blocks.data(), two_blocks.size(), digest);
+    success &= test_true(std::equal(digest, digest + 32, from_hex(
+        "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1").begin()));
+    sha256(long_message.data(), long_message.size(), digest);
+    success &= test_true(std::equal(digest, digest + 32, from_hex(
+        "5097e7d587352f5097062ae679f37bda5802d9f875aba14c8cb4d1a188ada179").begin()));
+    }
+    {
+    uint8_t digest[64];
+    sha512("abc", 3, digest);
+    success &= test_true(std::equal(digest, digest + 64, from_hex(
+        "ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a"
+        "2192992a274fc1a836ba3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f").begin()));
+    sha512("", 0, digest);
+    success &= test_true(std::equal(digest, digest + 64, from_hex(
+        "cf83e1357eefb8bdf1542850d66d8007d620e4050b5715dc83f4a921d36ce9ce"
+        "47d0d13c5d85f2b0ff8318d2877eec2f63b931bd47417a81a538327af927da3e").begin()));
+    sha512(long_message.data(), long_message.size(), digest);
+    success &= test_true(std::equal(digest, digest + 64, from_hex(
+        "b41d42e106eca6bf57123566b7ed1550c37d33af23afbfa8e302dfd44c988b30"
+        "03a26b4140ef42f535e66ea424e7c4a31616307269e6d520a6508f726da23d0a").begin()));
+    }
+
+    // every message of a multi-buffer call hashes as on its own
+    std::cout << "sha256_multi, sha512_multi" << std::endl;
+    for(size_t count : {1, 2, 3, 5, 17}){
+        for(size_t size : {0, 55, 56, 64, 111, 112, 300}){
+            std::vector<std::vector<uint8_t>> messages(count);
+            std::vector<const uint8_t*> pointers(count);
+            std::vector<uint8_t> digests256(32 * count), digests512(64 * count);
+            std::vector<uint8_t*> out256(count), out512(count);
+            for(size_t i = 0; i < count; i++){
+                messages[i] = random_bytes(size);
+                pointers[i] = messages[i].data();
+                out256[i] = digests256.data() + 32 * i;
+                out512[i] = digests512.data() + 64 * i;
+            }
+            sha256_multi(pointers.data(), size, out256.data(), count);
+            sha512_multi(pointers.data(), size, out512.data(), count);
+            bool ok = true;
+            for(size_t i = 0; i < count; i++){
+                uint8_t d256[32], d512[64];
+                sha256(messages[i].data(), size, d256);
+                sha512(messages[i].data(), size, d512);
+                ok &= std::equal(d256, d256 + 32, out256[i]);
+                ok &= std::equal(d512, d512 + 64, out512[i]);
+            }
+            if(!ok)
+                std::cout << "mismatch for " << count << " messages of size " << size << std::endl;
+            success &= test_true(ok);
+        }
+    }
+    return success;
+}
+
+
+int main(){
+    std::srand(std::time(nullptr));
+
+    bool success = true;
+    success &= test_aes();
+    success &= test_aes_ctr();
+    success &= test_sha2();
+
+    return success ? 0 : -1;
+}
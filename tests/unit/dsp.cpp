@@ -0,0 +1,162 @@
+#include <rvv/rvv.hpp>
+#include <rvv/dsp.hpp>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+
+
+bool test_true(bool x){
+    if(!x){
+        std::cout << "Test failed!" << std::endl;
+    }
+    return x;
+}
+
+// reference in double, or in Q30 with the rounding and saturation of Q15
+template <typename T>
+std::vector<T> reference(const std::vector<T>& signal, const std::vector<T>& kernel, bool reverse){
+    const size_t k = kernel.size();
+    std::vector<T> out;
+    for(size_t i = 0; i + k <= signal.size(); i++){
+        if constexpr(std::is_floating_point_v<T>){
+            double sum = 0;
+            for(size_t j = 0; j < k; j++)
+                sum += double(kernel[reverse ? k - 1 - j : j]) * double(signal[i + j]);
+            out.push_back(T(sum));
+        }
+        else{
+            int64_t sum = 0;
+            for(size_t j = 0; j < k; j++)
+                sum += int64_t(kernel[reverse ? k - 1 - j : j]) * int64_t(signal[i + j]);
+            out.push_back(T(std::clamp<int64_t>((sum + (1 << 14)) >> 15, INT16_MIN, INT16_MAX)));
+        }
+    }
+    return out;
+}
+
+template <typename T>
+bool equal(const std::vector<T>& x, const std::vector<T>& y){
+    for(size_t i = 0; i < y.size(); i++){
+        if constexpr(std::is_floating_point_v<T>){
+            if(!(std::abs(x[i] - y[i]) <= T(1e-4) * (T(1) + std::abs(y[i]))))
+                return false;
+        }
+        else if(x[i] != y[i])
+            return false;
+    }
+    return true;
+}
+
+template <typename T>
+bool test(){
+    bool success = true;
+    const size_t lanes = RVV_LEN / (std::is_same_v<T, double> ? 64 : 32);
+
+    std::cout << "fir, convolve, correlate" << std::endl;
+    for(size_t taps : {size_t(1), size_t(2), size_t(7), size_t(33)}){
+        for(size_t size : {taps - 1, taps, taps + 1, taps + lanes, taps + 5 * lanes + 3, size_t(1000)}){
+            std::vector<T> signal(size), kernel(taps);
+            for(auto& x : signal)
+                x = std::is_floating_point_v<T> ? T(std::rand() % 200 - 100) / T(16) : T(std::rand() % 65536 - 32768);
+            // Q15 taps that sum to less than 1 in magnitude, and a full scale
+            // tap to check the saturation
+            for(auto& h : kernel)
+                h = std::is_floating_point_v<T> ? T(std::rand() % 200 - 100) / T(64) : T(std::rand() % (65536 / taps) - 32768 / taps);
+            if(!std::is_floating_point_v<T> && taps == 1 && size > 0){
+                kernel[0] = T(-32768);
+                signal[0] = T(-32768);
+            }
+
+            const size_t outputs = size >= taps ? size - taps + 1 : 0;
+            std::vector<T> out(outputs + 1, T(5));
+            bool ok = rvv::dsp::fir(signal, kernel, out) == outputs;
+            ok &= equal(out, reference(signal, kernel, true)) && out.back() == T(5);
+            ok &= rvv::dsp::convolve(signal, kernel, out) == outputs;
+            ok &= equal(out, reference(signal, kernel, true));
+            ok &= rvv::dsp::correlate(signal, kernel, out) == outputs;
+            ok &= equal(out, reference(signal, kernel, false)) && out.back() == T(5);
+            if(!ok)
+                std::cout << "mismatch for " << taps << " taps, size " << size << std::endl;
+            success &= test_true(ok);
+        }
+    }
+    return success;
+}
+
+template <typename T>
+bool test_biquad(){
+    bool success = true;
+    const size_t lanes = RVV_LEN / (8 * sizeof(T));
+
+    std::cout << "biquad_bank" << std::endl;
+    for(size_t channels : {size_t(1), lanes - 1, size_t(64), 2 * lanes + 3}){
+        for(size_t sections : {size_t(0), size_t(1), size_t(3)}){
+            const size_t frames = 150;
+            rvv::dsp::biquad_bank<T> bank(channels, sections);
+            // stable sections with poles inside the unit circle
+            std::vector<rvv::dsp::biquad<T>> coefficients(channels * sections);
+            for(size_t c = 0; c < channels; c++){
+                for(size_t s = 0; s < sections; s++){
+                    auto& q = coefficients[c * sections + s];
+                    T r = T(0.5) + T(std::rand() % 40) / T(100);
+                    T theta = T(std::rand() % 314) / T(100);
+                    q = {T(0.3), T(std::rand() % 100) / T(200), T(0.1), T(-2) * r * std::cos(theta), r * r};
+                    bank.set(c, s, q);
+                }
+            }
+            std::vector<T> in(frames * channels), out(frames * channels);
+            for(auto& x : in)
+                x = T(std::rand() % 200 - 100) / T(64);
+
+            // scalar transposed direct form II per channel
+            std::vector<T> expected(in);
+            for(size_t c = 0; c < channels; c++){
+                for(size_t s = 0; s < sections; s++){
+                    const auto& q = coefficients[c * sections + s];
+                    T s1 = T(0), s2 = T(0);
+                    for(size_t f = 0; f < frames; f++){
+                        T x = expected[f * channels + c];
+                        T y = q.b0 * x + s1;
+                        s1 = q.b1 * x - q.a1 * y + s2;
+                        s2 = q.b2 * x - q.a2 * y;
+                        expected[f * channels + c] = y;
+                    }
+                }
+            }
+
+            // in two calls, the state carries over
+            const size_t split = 70;
+            rvv::dsp::process(bank, in.data(), out.data(), split);
+            rvv::dsp::process(bank, in.data() + split * channels, out.data() + split * channels, frames - split);
+            bool ok = equal(out, expected);
+            bank.reset();
+            rvv::dsp::process(bank, in.data(), in.data(), frames);
+            ok &= equal(in, expected);
+            if(!ok)
+                std::cout << "mismatch for " << channels << " channels, " << sections << " sections" << std::endl;
+            success &= test_true(ok);
+        }
+    }
+    return success;
+}
+
+int main(){
+    std::srand(std::time(nullptr));
+
+    bool success = true;
+
+    std::cout << "Testing float" << std::endl;
+    success &= test<float>();
+    success &= test_biquad<float>();
+    std::cout << "Testing double" << std::endl;
+    success &= test<double>();
+    success &= test_biquad<double>();
+    std::cout << "Testing int16_t (Q15)" << std::endl;
+    success &= test<int16_t>();
+
+    return success ? 0 : -1;
+}
@@ -1,251 +1,123 @@
-#include <sve/sve.hpp>
+#include <rvv/rvv.hpp>
+#include <rvv/fft.hpp>
 #include <iostream>
 #include <vector>
-#include <numeric>
-
-#include <complex>
+#include <cmath>
+#include <stdexcept>
+#include <cstdint>
 #include <cstdlib>
-#include <vector>
-#include <iostream>
-#include <cassert>
-#include <fstream>
+#include <ctime>
 
-template <typename T>
-inline void complex_mul(T a, T b, T c, T d, T& res_re, T& res_im)
-{
-    res_re = a*c - b*d;
-    res_im = a*d + b*c;
-}
 
-template <typename T>
-std::vector<T> gen_signal(T freq)
-{
-    const T PI = acos(-1);
-    T sf = T(16) * freq;
-    T ts = 1/sf;
-    std::vector<T> ret(sf, 0);
-    int idx = 0;
-    for (T i = T(0); i < T(1); i += ts)
-    {
-        ret[idx++] = T(10) * sin(T(2.0) * PI * freq * i);
+bool test_true(bool x){
+    if(!x){
+        std::cout << "Test failed!" << std::endl;
     }
-    return ret;
+    return x;
 }
 
+// absolute error against the largest expected magnitude
 template <typename T>
-void fft(std::vector<T>& re, std::vector<T>& im, bool invert) {
-    const T PI = acos(-1);
-    int n = re.size();
-
-    for (int i = 1, j = 0; i < n; i++) {
-        int bit = n >> 1;
-        for (; j & bit; bit >>= 1)
-            j ^= bit;
-        j ^= bit;
-        if (i < j)
-        {
-            std::swap(re[i], re[j]);
-            std::swap(im[i], im[j]);
-        }
-    }
-
-    for (int len = 2; len <= n; len <<= 1) {
-        T ang = 2 * PI / len * (invert ? -1 : 1);
-        T wlen_re = cos(ang);
-        T wlen_im = sin(ang);
-        for (int i = 0; i < n; i += len) {
-            T w_re = 1;
-            T w_im = 0;
-            for (int j = 0; j < len / 2; j++) {
-                int u = i+j;
-                int v = i+j+len/2;
-                T u_re = re[u];
-                T u_im = im[u];
-                T v_re = re[v];
-                T v_im = im[v];
-                complex_mul(v_re, v_im, w_re, w_im, v_re, v_im);
-                re[u] = u_re + v_re;
-                im[u] = u_im + v_im;
-                re[v] = u_re - v_re;
-                im[v] = u_im - v_im;
-                complex_mul(w_re, w_im, wlen_re, wlen_im, w_re, w_im);
-            }
-        }
-    }
-
-    if (invert) {
-        for (T & x : re)
-            x /= n;
-        for (T & x : im)
-            x /= n;
-    }
+bool approximately_equal(const std::vector<T>& x, const std::vector<double>& y, T tolerance){
+    double largest = 0;
+    for(double v : y)
+        largest = std::max(largest, std::abs(v));
+    for(size_t i = 0; i < x.size(); i++)
+        if(!(std::abs(double(x[i]) - y[i]) <= double(tolerance) * (1 + largest)))
+            return false;
+    return true;
 }
 
 template <typename T>
-void fft_simd(std::vector<T>& re, std::vector<T>& im, bool invert) {
-    using simd_t = sve::experimental::simd<T>;
-    const T PI = acos(-1);
-
-    int n = re.size();
-
-    for (int i = 1, j = 0; i < n; i++) {
-        int bit = n >> 1;
-        for (; j & bit; bit >>= 1)
-            j ^= bit;
-        j ^= bit;
-
-        if (i < j)
-        {
-            std::swap(re[i], re[j]);
-            std::swap(im[i], im[j]);
+bool test(){
+    bool success = true;
+    const T tolerance = std::is_same_v<T, float> ? T(1e-5) : T(1e-12);
+
+    std::cout << "plan, execute" << std::endl;
+    for(size_t n = 1; n <= 2048; n *= 2){
+        std::vector<T> re(n), im(n);
+        for(size_t i = 0; i < n; i++){
+            re[i] = T(std::rand() % 200 - 100) / T(32);
+            im[i] = T(std::rand() % 200 - 100) / T(32);
         }
-    }
-
-    for (int len = 2; len <= n; len <<= 1) {
-        if (len < 2 * (int)simd_t::size())
-        {
-            T ang = 2 * PI / len * (invert ? -1 : 1);
-
-            T wlen_re = cos(ang);
-            T wlen_im = sin(ang);
-            for (int i = 0; i < n; i += len) {
-
-                T w_re = 1;
-                T w_im = 0;
-
-                for (int j = 0; j < len / 2; j++) {
-                    int u = i+j;
-                    int v = i+j+len/2;
 
-                    T u_re = re[u];
-                    T u_im = im[u];
-                    T v_re = re[v];
-                    T v_im = im[v];
-                    complex_mul(v_re, v_im, w_re, w_im, v_re, v_im);
-
-                    re[u] = u_re + v_re;
-                    im[u] = u_im + v_im;
-
-                    re[v] = u_re - v_re;
-                    im[v] = u_im - v_im;
-
-                    complex_mul(w_re, w_im, wlen_re, wlen_im, w_re, w_im);
-                }
+        // naive DFT in double
+        const double pi = std::acos(-1.0);
+        std::vector<double> expected_re(n), expected_im(n);
+        for(size_t k = 0; k < n; k++){
+            for(size_t j = 0; j < n; j++){
+                const double angle = -2 * pi * double(j * k % n) / double(n);
+                expected_re[k] += re[j] * std::cos(angle) - im[j] * std::sin(angle);
+                expected_im[k] += re[j] * std::sin(angle) + im[j] * std::cos(angle);
             }
         }
-        else
-        {
-            T ang = 2 * PI / len * (invert ? -1 : 1);
-            T cos_ang = cos(ang), sin_ang = sin(ang);
-            simd_t wlen_re(cos_ang);
-            simd_t wlen_im(sin_ang);
-            for (int i = 0; i < n; i += len) 
-            {
-                std::vector<T> w_re_arr(simd_t::size(), 0), w_im_arr(simd_t::size(), 0);
-                w_re_arr[0] = 1;
-                w_im_arr[0] = 0;
-                for (int k = 1; k < w_im_arr.size(); k++)
-                {
-                    complex_mul(w_re_arr[k-1], w_im_arr[k-1],cos_ang, sin_ang, w_re_arr[k], w_im_arr[k]);
-                }
-
-                simd_t w_re(w_re_arr.data(), sve::experimental::vector_aligned);
-                simd_t w_im(w_im_arr.data(), sve::experimental::vector_aligned);
-                auto w_re_init = w_re;
-                auto w_im_init = w_im;
-                for (int j = 0; j < len / 2; j += simd_t::size()) 
-                {
-                    int u = i+j;
-                    int v = i+j+len/2;
-
-                    simd_t u_re(re.data() + u, sve::experimental::vector_aligned);
-                    simd_t u_im(im.data() + u, sve::experimental::vector_aligned);
-                    simd_t v_re(re.data() + v, sve::experimental::vector_aligned);
-                    simd_t v_im(im.data() + v, sve::experimental::vector_aligned);
-
-                    complex_mul(v_re, v_im, w_re, w_im, v_re, v_im);
 
-                    auto uv_re = u_re + v_re;
-                    auto uv_im = u_im + v_im;
-                    uv_re.copy_to(re.data() + u, sve::experimental::vector_aligned);
-                    uv_im.copy_to(im.data() + u, sve::experimental::vector_aligned);
-
-                    uv_re = u_re - v_re;
-                    uv_im = u_im - v_im;
-                    uv_re.copy_to(re.data() + v, sve::experimental::vector_aligned);
-                    uv_im.copy_to(im.data() + v, sve::experimental::vector_aligned);
-
-                    complex_mul(w_re_init, w_im_init, 
-                            simd_t(w_re.last()), simd_t(w_im.last()), w_re, w_im);
-                    complex_mul(w_re, w_im, 
-                            wlen_re, wlen_im, w_re, w_im);
-                }
-            }  
+        rvv::fft::plan<T> plan(n);
+        std::vector<T> out_re(n + 1, T(7)), out_im(n + 1, T(7));
+        std::vector<T> back_re(n), back_im(n);
+        bool ok = plan.size() == n;
+        // the twiddle tables start on a register boundary
+        ok &= reinterpret_cast<std::uintptr_t>(plan.twiddles.data()) %
+            (rvv::experimental::simd<T>::size() * sizeof(T)) == 0;
+        // the plan is reused for the second forward transform
+        for(int repeat = 0; repeat < 2; repeat++){
+            plan.execute(re.data(), im.data(), out_re.data(), out_im.data());
+            ok &= out_re.back() == T(7) && out_im.back() == T(7);
+            out_re.pop_back();
+            out_im.pop_back();
+            ok &= approximately_equal(out_re, expected_re, tolerance);
+            ok &= approximately_equal(out_im, expected_im, tolerance);
+            out_re.push_back(T(7));
+            out_im.push_back(T(7));
         }
+
+        plan.execute(out_re.data(), out_im.data(), back_re.data(), back_im.data(), rvv::fft::direction::inverse);
+        ok &= approximately_equal(back_re, std::vector<double>(re.begin(), re.end()), tolerance);
+        ok &= approximately_equal(back_im, std::vector<double>(im.begin(), im.end()), tolerance);
+        if(!ok)
+            std::cout << "mismatch for n = " << n << std::endl;
+        success &= test_true(ok);
     }
 
-    if (invert) {
-        if (n < (int)simd_t::size())
-        {
-            for (T & x : re)
-                x /= n;
-            for (T & x : im)
-                x /= n;
-        }
-        else
-        {
-            for (int i = 0; i < n; i += simd_t::size())
-            {
-                simd_t v(re.data() + i, sve::experimental::vector_aligned);
-                v /= n;
-                v.copy_to(re.data() + i, sve::experimental::vector_aligned);
-            }
+    std::cout << "peak of a sine" << std::endl;
+    for(size_t freq = 32; freq <= 256; freq *= 2){
+        // 16 samples per period over one second
+        const size_t n = 16 * freq;
+        const double pi = std::acos(-1.0);
+        std::vector<T> re(n), im(n, T(0)), out_re(n), out_im(n);
+        for(size_t i = 0; i < n; i++)
+            re[i] = T(10 * std::sin(2 * pi * double(freq) * double(i) / double(n)));
+        rvv::fft::plan<T> plan(n);
+        plan.execute(re.data(), im.data(), out_re.data(), out_im.data());
+        size_t peak = 0;
+        for(size_t i = 0; i < n / 2; i++)
+            if(std::hypot(out_re[i], out_im[i]) > std::hypot(out_re[peak], out_im[peak]))
+                peak = i;
+        success &= test_true(peak == freq);
+    }
 
-            for (int i = 0; i < n; i += simd_t::size())
-            {
-                simd_t v(im.data() + i, sve::experimental::vector_aligned);
-                v /= n;
-                v.copy_to(im.data() + i, sve::experimental::vector_aligned);
-            }
-        }
+    std::cout << "length not a power of two" << std::endl;
+    bool thrown = false;
+    try{
+        rvv::fft::plan<T> plan(12);
     }
+    catch(const std::invalid_argument&){
+        thrown = true;
+    }
+    success &= test_true(thrown);
+    return success;
 }
 
-template <typename T>
-void test_fft(T freq)
-{
 
-    using cd = std::complex<T>;
-    auto x = gen_signal(freq);
-    auto x_re = x;
-    auto x_re_simd = x;
-    std::vector<T> x_im(x_re.size(), 0);
-    std::vector<T> x_im_simd(x_re_simd.size(), 0);
+int main(){
+    std::srand(std::time(nullptr));
 
-    fft(x_re, x_im, false);
-    fft_simd(x_re_simd, x_im_simd, false);
-    T max_power = 0;
-    T output_freq = 0;
-    for (int i = 0; i < x_re.size()/2; i++)
-    {
-        T max_power_curr = std::abs(cd(x_re_simd[i], x_im_simd[i]));
-        if (max_power_curr > max_power)
-        {
-            max_power = max_power_curr;
-            output_freq = i;
-        }
-    }
-    fft(x_re, x_im, true);
-    fft_simd(x_re_simd, x_im_simd, true);
-    assert(output_freq == freq);
-    std::cout << typeid(T).name() << " freq : " << freq << "\tN samples : " << x.size() << "\toutput_freq : " << output_freq << '\n';
-}
+    bool success = true;
 
-int main()
-{
-    for (int i = 5; i <= 8; i++)
-    {
-        test_fft<float>(float(std::pow(2, i)));
-        test_fft<double>(double(std::pow(2, i)));
-    }
-}
\ No newline at end of file
+    std::cout << "Testing float" << std::endl;
+    success &= test<float>();
+    std::cout << "Testing double" << std::endl;
+    success &= test<double>();
+
+    return success ? 0 : -1;
+}
@@ -0,0 +1,61 @@
+#include <rvv/rvv.hpp>
+#include <rvv/histogram.hpp>
+#include <iostream>
+#include <span>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
+
+
+bool test_true(bool x){
+    if(!x){
+        std::cout << "Test failed!" << std::endl;
+    }
+    return x;
+}
+
+template <typename T>
+bool test(){
+    bool success = true;
+    const size_t lanes = rvv::experimental::simd<uint32_t>::size();
+
+    std::cout << "histogram" << std::endl;
+    for(size_t bins : {size_t(1), size_t(7), size_t(256), size_t(257), size_t(5000)}){
+        for(size_t size : {size_t(0), size_t(1), lanes - 1, lanes, 3 * lanes + 1, size_t(1000), size_t(20011)}){
+            // values past the last bin, and all equal values
+            for(size_t range : {bins + bins / 4 + 3, size_t(1)}){
+                std::vector<T> data(size);
+                for(auto& x : data)
+                    x = T(std::rand() % range);
+                if(std::is_signed_v<T> && size > 0)
+                    data[size / 2] = T(-1);
+
+                std::vector<uint32_t> expected(bins, 3), counts(bins + 1, 3);
+                for(auto x : data)
+                    if(x >= 0 && size_t(x) < bins)
+                        expected[size_t(x)]++;
+                rvv::histogram(data, std::span(counts.data(), bins));
+                bool ok = std::equal(expected.begin(), expected.end(), counts.begin()) && counts[bins] == 3;
+                if(!ok)
+                    std::cout << "mismatch for " << bins << " bins, size " << size << std::endl;
+                success &= test_true(ok);
+            }
+        }
+    }
+    return success;
+}
+
+
+int main(){
+    std::srand(std::time(nullptr));
+
+    bool success = true;
+
+    std::cout << "Testing uint32_t" << std::endl;
+    success &= test<uint32_t>();
+    std::cout << "Testing int32_t" << std::endl;
+    success &= test<int32_t>();
+
+    return success ? 0 : -1;
+}
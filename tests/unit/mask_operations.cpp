@@ -115,6 +115,19 @@ bool test(){
   
     }
 
+    {
+        // find_first_set
+        simd_mask<T> x1;
+        for (size_t i = 0; i < simd_size; i++)
+            x1.set(i, random_mask[i]);
+        auto first = std::find(random_mask.begin(), random_mask.end(), true);
+        int expected = first == random_mask.end() ? -1 : int(first - random_mask.begin());
+        std::cout << "find_first_set: " << find_first_set(x1) << std::endl;
+        success &= test_true(find_first_set(x1) == expected);
+        success &= test_true(find_first_set(simd_mask<T>(false)) == -1);
+        success &= test_true(find_first_set(simd_mask<T>(true)) == 0);
+    }
+
     // choose / mask_assign
     {
         simd_mask<T> x1(false);
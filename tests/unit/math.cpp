@@ -0,0 +1,269 @@
+#include <rvv/rvv.hpp>
+#include <rvv/math.hpp>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <ctime>
+
+
+bool test_true(bool x){
+    if(!x){
+        std::cout << "Test failed!" << std::endl;
+    }
+    return x;
+}
+
+// distance to the long double reference in units of the last place of T
+template <typename T>
+double ulp_error(T result, long double reference){
+    if(std::isnan(reference))
+        return std::isnan(result) ? 0.0 : 1e9;
+    if(std::isinf(reference) || std::isinf(result))
+        return (result == T(reference)) ? 0.0 : 1e9;
+    if(reference == 0 && result == 0)
+        return std::signbit(result) == std::signbit(reference) ? 0.0 : 1e9;
+    int exp;
+    std::frexp(T(reference), &exp);
+    exp = std::max(exp, std::numeric_limits<T>::min_exponent);
+    long double ulp = std::ldexp(1.0L, exp - std::numeric_limits<T>::digits);
+    return double(std::fabs((long double)result - reference) / ulp);
+}
+
+template <typename T>
+T random_in(double lo, double hi){
+    return T(lo + (hi - lo) * (std::rand() / double(RAND_MAX)));
+}
+
+// Runs a unary function over the inputs and reports the worst ULP error
+template <typename T, typename F, typename Ref>
+bool test_unary(const char* name, const std::vector<T>& inputs, F f, Ref ref, double max_ulp){
+    using namespace rvv::experimental;
+    const int simd_size = simd<T>::size();
+
+    double worst = 0;
+    T worst_input = 0;
+    std::vector<T> out(simd_size);
+    for(size_t i = 0; i + simd_size <= inputs.size(); i += simd_size){
+        simd<T> x(inputs.data() + i, element_aligned);
+        f(x).copy_to(out.data(), element_aligned);
+        for(int j = 0; j < simd_size; j++){
+            double err = ulp_error(out[j], ref((long double)inputs[i + j]));
+            if(err > worst){
+                worst = err;
+                worst_input = inputs[i + j];
+            }
+        }
+    }
+    std::cout << name << ": max error " << worst << " ulp (at " << worst_input << ")" << std::endl;
+    return test_true(worst <= max_ulp);
+}
+
+template <typename T>
+std::vector<T> random_inputs(double lo, double hi, int count = 4096){
+    std::vector<T> data(count);
+    std::generate(data.begin(), data.end(), [=](){ return random_in<T>(lo, hi); });
+    return data;
+}
+
+// log-uniform positive values over [2^lo, 2^hi]
+template <typename T>
+std::vector<T> random_positive_inputs(int lo, int hi, int count = 4096){
+    std::vector<T> data(count);
+    std::generate(data.begin(), data.end(), [=](){
+        return T(std::exp2(random_in<double>(lo, hi)));
+    });
+    return data;
+}
+
+// a padded vector of special values, repeated to fill whole simd registers
+template <typename T>
+std::vector<T> special_inputs(){
+    const T inf = std::numeric_limits<T>::infinity();
+    std::vector<T> data = {T(0), T(-0.0), T(1), T(-1), T(0.5), T(2), inf, -inf,
+        std::numeric_limits<T>::quiet_NaN(), std::numeric_limits<T>::min(),
+        std::numeric_limits<T>::denorm_min(), std::numeric_limits<T>::max(),
+        -std::numeric_limits<T>::max()};
+    const int simd_size = rvv::experimental::simd<T>::size();
+    while(data.size() % simd_size != 0)
+        data.push_back(T(1));
+    return data;
+}
+
+template <typename T>
+bool test(){
+    bool success = true;
+    using namespace rvv::experimental;
+    using simd_t = simd<T>;
+    const bool is_float = std::is_same_v<T, float>;
+
+    std::cout << "exp" << std::endl;
+    {
+    auto ref = [](long double v){ return std::exp(v); };
+    auto f = [](simd_t x){ return exp(x); };
+    success &= test_unary("exp", random_inputs<T>(-20, 20), f, ref, 2);
+    success &= test_unary("exp (full range)", random_inputs<T>(is_float ? -103 : -745, is_float ? 88 : 709), f, ref, 2);
+    success &= test_unary("exp (special)", special_inputs<T>(), f, ref, 2);
+    }
+
+    std::cout << "exp2" << std::endl;
+    {
+    auto ref = [](long double v){ return std::exp2(v); };
+    auto f = [](simd_t x){ return exp2(x); };
+    success &= test_unary("exp2", random_inputs<T>(is_float ? -149 : -1074, is_float ? 127 : 1023), f, ref, 2);
+    success &= test_unary("exp2 (special)", special_inputs<T>(), f, ref, 2);
+    }
+
+    std::cout << "log, log2, log10" << std::endl;
+    {
+    auto inputs = random_positive_inputs<T>(is_float ? -140 : -1060, is_float ? 127 : 1023);
+    auto near_one = random_inputs<T>(0.5, 2);
+    success &= test_unary("log", inputs, [](simd_t x){ return log(x); }, [](long double v){ return std::log(v); }, 2);
+    success &= test_unary("log (near 1)", near_one, [](simd_t x){ return log(x); }, [](long double v){ return std::log(v); }, 2);
+    success &= test_unary("log (special)", special_inputs<T>(), [](simd_t x){ return log(x); }, [](long double v){ return std::log(v); }, 1);
+    success &= test_unary("log2", inputs, [](simd_t x){ return log2(x); }, [](long double v){ return std::log2(v); }, 2);
+    success &= test_unary("log2 (near 1)", near_one, [](simd_t x){ return log2(x); }, [](long double v){ return std::log2(v); }, 2);
+    success &= test_unary("log10", inputs, [](simd_t x){ return log10(x); }, [](long double v){ return std::log10(v); }, 2);
+    success &= test_unary("log10 (near 1)", near_one, [](simd_t x){ return log10(x); }, [](long double v){ return std::log10(v); }, 2);
+    }
+
+    std::cout << "sin, cos" << std::endl;
+    {
+    auto small = random_inputs<T>(-10, 10);
+    auto large = random_inputs<T>(-1e4, 1e4);
+    auto huge = random_inputs<T>(-1e12, 1e12);
+    auto sin_f = [](simd_t x){ return sin(x); };
+    auto cos_f = [](simd_t x){ return cos(x); };
+    auto sin_ref = [](long double v){ return std::sin(v); };
+    auto cos_ref = [](long double v){ return std::cos(v); };
+    success &= test_unary("sin", small, sin_f, sin_ref, 2);
+    success &= test_unary("sin (large)", large, sin_f, sin_ref, 2);
+    success &= test_unary("sin (huge)", huge, sin_f, sin_ref, 2);
+    success &= test_unary("cos", small, cos_f, cos_ref, 2);
+    success &= test_unary("cos (large)", large, cos_f, cos_ref, 2);
+    success &= test_unary("cos (huge)", huge, cos_f, cos_ref, 2);
+    success &= test_unary("sin (special)", special_inputs<T>(), sin_f, sin_ref, 2);
+    success &= test_unary("cos (special)", special_inputs<T>(), cos_f, cos_ref, 2);
+    }
+
+    std::cout << "tanh" << std::endl;
+    {
+    auto f = [](simd_t x){ return tanh(x); };
+    auto ref = [](long double v){ return std::tanh(v); };
+    success &= test_unary("tanh", random_inputs<T>(-1, 1), f, ref, 3);
+    success &= test_unary("tanh (wide)", random_inputs<T>(-30, 30), f, ref, 3);
+    success &= test_unary("tanh (special)", special_inputs<T>(), f, ref, 3);
+    }
+
+    std::cout << "erf" << std::endl;
+    {
+    auto f = [](simd_t x){ return erf(x); };
+    auto ref = [](long double v){ return std::erf(v); };
+    success &= test_unary("erf", random_inputs<T>(-1, 1), f, ref, 3);
+    success &= test_unary("erf (wide)", random_inputs<T>(-7, 7), f, ref, 3);
+    success &= test_unary("erf (special)", special_inputs<T>(), f, ref, 3);
+    }
+
+    std::cout << "pow" << std::endl;
+    {
+    const int simd_size = simd_t::size();
+    const int count = 4096;
+    std::vector<T> xs(count), ys(count), out(simd_size);
+    for(int i = 0; i < count; i++){
+        xs[i] = random_in<T>(0, 20);
+        ys[i] = random_in<T>(-20, 20);
+    }
+    // negative bases with integral exponents
+    for(int i = 0; i < count / 4; i++){
+        xs[i] = -xs[i];
+        ys[i] = std::round(ys[i]);
+    }
+    double worst = 0;
+    for(int i = 0; i < count; i += simd_size){
+        simd_t x(xs.data() + i, element_aligned);
+        simd_t y(ys.data() + i, element_aligned);
+        pow(x, y).copy_to(out.data(), element_aligned);
+        for(int j = 0; j < simd_size; j++){
+            long double reference = std::pow((long double)xs[i + j], (long double)ys[i + j]);
+            worst = std::max(worst, ulp_error(out[j], reference));
+        }
+    }
+    std::cout << "pow: max error " << worst << " ulp" << std::endl;
+    success &= test_true(worst <= 4);
+
+    // special values
+    const T inf = std::numeric_limits<T>::infinity();
+    const T nan = std::numeric_limits<T>::quiet_NaN();
+    std::vector<T> sx = {T(2), T(-2), T(-2), T(0), T(-1), T(1), T(-8), T(nan), T(2), T(0.5), T(-0.0), T(4),
+        T(0), T(-0.0), T(0), T(-0.0), T(-0.0), T(0), T(-0.0), T(0),
+        T(nan), T(nan), T(nan), T(2), T(0),
+        inf, inf, -inf, -inf, -inf, -inf, -inf, inf, inf};
+    std::vector<T> sy = {T(0), T(3), T(0.5), T(2), inf, T(nan), T(1.0/3), T(0), T(-1), inf, T(3), T(0.5),
+        T(0.5), T(0.5), T(-0.5), T(-0.5), T(-3), T(-3), T(-2), -inf,
+        T(2), T(-3), T(nan), T(nan), T(nan),
+        T(0.5), T(-0.5), T(0.5), T(-0.5), T(3), T(-3), T(2), inf, -inf};
+    while(sx.size() % simd_size != 0){
+        sx.push_back(T(1));
+        sy.push_back(T(1));
+    }
+    bool special_ok = true;
+    for(size_t i = 0; i < sx.size(); i += simd_size){
+        simd_t x(sx.data() + i, element_aligned);
+        simd_t y(sy.data() + i, element_aligned);
+        pow(x, y).copy_to(out.data(), element_aligned);
+        for(int j = 0; j < simd_size; j++){
+            T expected = std::pow(sx[i + j], sy[i + j]);
+            bool equal = (std::isnan(expected) && std::isnan(out[j])) ||
+                (expected == out[j] && std::signbit(expected) == std::signbit(out[j]));
+            if(!equal)
+                std::cout << "pow(" << sx[i + j] << ", " << sy[i + j] << ") = " << out[j] << ", expected " << expected << std::endl;
+            special_ok &= equal;
+        }
+    }
+    success &= test_true(special_ok);
+    }
+
+    std::cout << "fast variants" << std::endl;
+    {
+    // relative error bound of the fast variants
+    const double tolerance = 1e-6;
+    const double ulp_tolerance = tolerance / std::numeric_limits<T>::epsilon();
+    success &= test_unary("fast_exp", random_inputs<T>(is_float ? -80 : -700, is_float ? 80 : 700),
+        [](simd_t x){ return fast_exp(x); }, [](long double v){ return std::exp(v); }, ulp_tolerance);
+    success &= test_unary("fast_log", random_positive_inputs<T>(-100, 100),
+        [](simd_t x){ return fast_log(x); }, [](long double v){ return std::log(v); }, ulp_tolerance);
+    // absolute error for the trigonometric ones, checked as ulp of 1
+    double worst = 0;
+    auto inputs = random_inputs<T>(-1000, 1000);
+    std::vector<T> s(simd_t::size()), c(simd_t::size());
+    for(size_t i = 0; i < inputs.size(); i += simd_t::size()){
+        simd_t x(inputs.data() + i, element_aligned);
+        fast_sin(x).copy_to(s.data(), element_aligned);
+        fast_cos(x).copy_to(c.data(), element_aligned);
+        for(size_t j = 0; j < simd_t::size(); j++){
+            worst = std::max(worst, double(std::fabs(s[j] - std::sin((long double)inputs[i + j]))));
+            worst = std::max(worst, double(std::fabs(c[j] - std::cos((long double)inputs[i + j]))));
+        }
+    }
+    std::cout << "fast_sin, fast_cos: max absolute error " << worst << std::endl;
+    success &= test_true(worst <= tolerance);
+    }
+
+    return success;
+}
+
+
+int main(){
+    std::srand(std::time(nullptr));
+
+    bool success = true;
+
+    std::cout << "Testing float" << std::endl;
+    success &= test<float>();
+    std::cout << "Testing double" << std::endl;
+    success &= test<double>();
+
+    return success ? 0 : -1;
+}
@@ -0,0 +1,131 @@
+#include <rvv/rvv.hpp>
+#include <rvv/mem.hpp>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <sys/mman.h>
+#include <unistd.h>
+
+
+bool test_true(bool x){
+    if(!x){
+        std::cout << "Test failed!" << std::endl;
+    }
+    return x;
+}
+
+std::vector<uint8_t> random_bytes(size_t size){
+    std::vector<uint8_t> data(size);
+    std::generate(data.begin(), data.end(), [](){ return uint8_t(std::rand()); });
+    return data;
+}
+
+const size_t sizes[] = {0, 1, 7, 15, 16, 17, 63, 64, 65, 255, 256, 257, 1000, 4096, 5001};
+
+bool test_copy_set(){
+    bool success = true;
+
+    std::cout << "copy, set" << std::endl;
+    for(size_t size : sizes){
+        // one guard byte on each side
+        auto src = random_bytes(size);
+        std::vector<uint8_t> dst(size + 2, 0xaa);
+        bool ok = rvv::mem::copy(dst.data() + 1, src.data(), size) == dst.data() + 1;
+        ok &= std::equal(src.begin(), src.end(), dst.begin() + 1);
+        ok &= dst.front() == 0xaa && dst.back() == 0xaa;
+        rvv::mem::set(dst.data() + 1, 0x5c, size);
+        ok &= std::all_of(dst.begin() + 1, dst.end() - 1, [](uint8_t x){ return x == 0x5c; });
+        ok &= dst.front() == 0xaa && dst.back() == 0xaa;
+        if(!ok)
+            std::cout << "mismatch for size " << size << std::endl;
+        success &= test_true(ok);
+    }
+    return success;
+}
+
+int sign(int x){
+    return (x > 0) - (x < 0);
+}
+
+bool test_compare_find(){
+    bool success = true;
+
+    std::cout << "compare" << std::endl;
+    for(size_t size : sizes){
+        auto a = random_bytes(size);
+        auto b = a;
+        bool ok = rvv::mem::compare(a.data(), b.data(), size) == 0;
+        for(size_t i : {size_t(0), size / 2, size - 1}){
+            if(i >= size)
+                continue;
+            b = a;
+            b[i] = uint8_t(a[i] + 1 + std::rand() % 255);
+            ok &= sign(rvv::mem::compare(a.data(), b.data(), size)) == sign(std::memcmp(a.data(), b.data(), size));
+            ok &= rvv::mem::compare(b.data(), a.data(), size) == int(b[i]) - int(a[i]);
+        }
+        if(!ok)
+            std::cout << "mismatch for size " << size << std::endl;
+        success &= test_true(ok);
+    }
+
+    std::cout << "find" << std::endl;
+    for(size_t size : sizes){
+        std::vector<uint8_t> data(size, 1);
+        bool ok = rvv::mem::find(data.data(), 0, size) == nullptr;
+        for(size_t i : {size - 1, size / 2, size_t(0)}){
+            if(i >= size)
+                continue;
+            data[i] = 0;
+            // the earliest of the marked positions
+            ok &= rvv::mem::find(data.data(), 0, size) == data.data() + i;
+        }
+        ok &= rvv::mem::find(data.data(), 0, size / 2) == (size > 1 ? data.data() : nullptr);
+        if(!ok)
+            std::cout << "mismatch for size " << size << std::endl;
+        success &= test_true(ok);
+    }
+    return success;
+}
+
+bool test_strlen(){
+    bool success = true;
+
+    // strings inside a page, and strings that end right before an unmapped
+    // page, where only fault-only-first loads keep strlen from faulting
+    std::cout << "strlen" << std::endl;
+    const size_t page = size_t(sysconf(_SC_PAGESIZE));
+    void* mapping = mmap(nullptr, 2 * page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(!test_true(mapping != MAP_FAILED))
+        return false;
+    char* buffer = static_cast<char*>(mapping);
+    success &= test_true(mprotect(buffer + page, page, PROT_NONE) == 0);
+    for(size_t length : {size_t(0), size_t(1), size_t(2), size_t(99), size_t(100), size_t(150), size_t(2000), page - 1}){
+        for(size_t start : {size_t(0), size_t(1), size_t(100), page - 1 - length}){
+            if(start + length >= page)
+                continue;
+            std::memset(buffer, 'x', page);
+            buffer[start + length] = '\0';
+            bool ok = rvv::mem::strlen(buffer + start) == length;
+            if(!ok)
+                std::cout << "mismatch for length " << length << " at " << start << std::endl;
+            success &= test_true(ok);
+        }
+    }
+    munmap(mapping, 2 * page);
+    return success;
+}
+
+
+int main(){
+    std::srand(std::time(nullptr));
+
+    bool success = true;
+    success &= test_copy_set();
+    success &= test_compare_find();
+    success &= test_strlen();
+
+    return success ? 0 : -1;
+}
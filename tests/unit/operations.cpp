@@ -7,6 +7,7 @@
 #include <ctime>
 #include <cstdlib>
 #include <concepts>
+#include <bit>
 
 
 bool test_true(bool x){
@@ -199,6 +200,173 @@ bool test(){
         success &= test_equal(x, data);
     }
 
+    // Bit manipulation
+    if constexpr(std::is_integral_v<T>)
+    {
+        using U = std::make_unsigned_t<T>;
+        std::vector<T> data(simd_size), data_y(simd_size), data_res(simd_size);
+        // random bit patterns over the full width, including 0 and all ones
+        for(int i = 0; i < simd_size; i++){
+            uint64_t bits = (uint64_t(std::rand()) << 40) ^ (uint64_t(std::rand()) << 20) ^ uint64_t(std::rand());
+            data[i] = T(bits >> (std::rand() % (sizeof(T) * 8)));
+            data_y[i] = T(std::rand());
+        }
+        data[0] = T(0);
+        data[1] = T(~U(0));
+        simd<T> x(data.data(), vector_aligned);
+        simd<T> y(data_y.data(), vector_aligned);
+        std::cout << "Bit manipulation" << std::endl;
+        std::cout << "popcount: " << std::endl;
+        std::transform(data.begin(), data.end(), data_res.begin(), [](T a){ return T(std::popcount(U(a))); });
+        success &= test_equal(popcount(x), data_res);
+        std::cout << "countl_zero: " << std::endl;
+        std::transform(data.begin(), data.end(), data_res.begin(), [](T a){ return T(std::countl_zero(U(a))); });
+        success &= test_equal(countl_zero(x), data_res);
+        std::cout << "countr_zero: " << std::endl;
+        std::transform(data.begin(), data.end(), data_res.begin(), [](T a){ return T(std::countr_zero(U(a))); });
+        success &= test_equal(countr_zero(x), data_res);
+        std::cout << "byteswap: " << std::endl;
+        std::transform(data.begin(), data.end(), data_res.begin(), [](T a){
+            U r = 0;
+            for(size_t i = 0; i < sizeof(T); i++)
+                r |= U((U(a) >> (8 * i)) & 0xff) << (8 * (sizeof(T) - 1 - i));
+            return T(r);
+        });
+        success &= test_equal(byteswap(x), data_res);
+        std::cout << "bit_reverse: " << std::endl;
+        std::transform(data.begin(), data.end(), data_res.begin(), [](T a){
+            U r = 0;
+            for(size_t i = 0; i < sizeof(T) * 8; i++)
+                r |= U((U(a) >> i) & 1) << (sizeof(T) * 8 - 1 - i);
+            return T(r);
+        });
+        success &= test_equal(bit_reverse(x), data_res);
+        std::cout << "andn: " << std::endl;
+        std::transform(data.begin(), data.end(), data_y.begin(), data_res.begin(), [](T a, T b){ return T(a & ~b); });
+        success &= test_equal(andn(x, y), data_res);
+    }
+
+    // Multiply high and division by invariants
+    if constexpr(std::is_integral_v<T>)
+    {
+        using U = std::make_unsigned_t<T>;
+        using wide = std::conditional_t<std::is_signed_v<T>, __int128, unsigned __int128>;
+        const int bits = 8 * sizeof(T);
+        std::vector<T> data_x(simd_size), data_y(simd_size), data_res(simd_size);
+        for(int i = 0; i < simd_size; i++){
+            uint64_t x_bits = (uint64_t(std::rand()) << 40) ^ (uint64_t(std::rand()) << 20) ^ uint64_t(std::rand());
+            uint64_t y_bits = (uint64_t(std::rand()) << 40) ^ (uint64_t(std::rand()) << 20) ^ uint64_t(std::rand());
+            data_x[i] = T(x_bits >> (std::rand() % bits));
+            data_y[i] = T(y_bits);
+        }
+        data_x[0] = std::numeric_limits<T>::min();
+        data_x[1] = std::numeric_limits<T>::max();
+        simd<T> x(data_x.data(), vector_aligned);
+        simd<T> y(data_y.data(), vector_aligned);
+        std::cout << "Multiply high" << std::endl;
+        std::cout << "mulhi: " << std::endl;
+        std::transform(data_x.begin(), data_x.end(), data_y.begin(), data_res.begin(), [&](T a, T b){
+            return T((wide(a) * wide(b)) >> bits);
+        });
+        success &= test_equal(mulhi(x, y), data_res);
+        if constexpr(std::is_signed_v<T>)
+        {
+            std::cout << "mulhsu: " << std::endl;
+            std::transform(data_x.begin(), data_x.end(), data_y.begin(), data_res.begin(), [&](T a, T b){
+                return T((__int128(a) * __int128(U(b))) >> bits);
+            });
+            success &= test_equal(mulhsu(x, simd_bit_cast<U>(y)), data_res);
+        }
+
+        std::cout << "divider: " << std::endl;
+        std::vector<T> divisors = {T(1), T(2), T(3), T(7), T(10), T(64), T(100),
+            std::numeric_limits<T>::max(), T(std::numeric_limits<T>::max() / 3), T(data_y[0] | 1)};
+        if constexpr(std::is_signed_v<T>)
+        {
+            for(T d : {T(-1), T(-2), T(-7), T(-100), std::numeric_limits<T>::min()})
+                divisors.push_back(d);
+            // min / -1 overflows
+            data_x[0] = T(data_x[0] + 1);
+            x = simd<T>(data_x.data(), vector_aligned);
+        }
+        else
+            divisors.push_back(T(std::numeric_limits<T>::max() / 2 + 2));
+        bool ok = true;
+        std::vector<T> out(simd_size);
+        for(T d : divisors){
+            divider<T> div(d);
+            (x / div).copy_to(out.data(), vector_aligned);
+            for(int i = 0; i < simd_size; i++)
+                ok &= out[i] == T(data_x[i] / d);
+            (x % div).copy_to(out.data(), vector_aligned);
+            for(int i = 0; i < simd_size; i++)
+                ok &= out[i] == T(data_x[i] % d);
+            if(!ok){
+                std::cout << "mismatch for divisor " << int64_t(d) << std::endl;
+                break;
+            }
+        }
+        success &= test_true(ok);
+
+        std::cout << "divide_by: " << std::endl;
+        auto check = [&](simd<T> q, auto d){
+            q.copy_to(out.data(), vector_aligned);
+            bool equal = true;
+            for(int i = 0; i < simd_size; i++)
+                equal &= out[i] == T(data_x[i] / T(d));
+            return equal;
+        };
+        ok = check(divide_by<1>(x), 1) && check(divide_by<7>(x), 7) &&
+            check(divide_by<16>(x), 16) && check(divide_by<100>(x), 100);
+        if constexpr(std::is_signed_v<T>)
+            ok &= check(divide_by<-1>(x), -1) && check(divide_by<-3>(x), -3) &&
+                check(divide_by<-8>(x), -8);
+        success &= test_true(ok);
+    }
+
+    // Carry chains
+    if constexpr(std::is_unsigned_v<T>)
+    {
+        std::vector<T> data_x(simd_size), data_y(simd_size), data_res(simd_size);
+        for(int i = 0; i < simd_size; i++){
+            uint64_t bits = (uint64_t(std::rand()) << 40) ^ (uint64_t(std::rand()) << 20) ^ uint64_t(std::rand());
+            data_x[i] = T(bits);
+            data_y[i] = T(bits >> (std::rand() % 8));
+        }
+        // the carry or borrow in decides the carry out
+        data_x[0] = T(~T(0));
+        data_y[0] = T(0);
+        simd<T> x(data_x.data(), vector_aligned);
+        simd<T> y(data_y.data(), vector_aligned);
+        simd_mask<T> carry_in = (simd<T>(simd<T>::index0123) & T(1)) == T(0);
+        simd_mask<T> carry_out;
+        std::cout << "Carry chains" << std::endl;
+        std::cout << "add_with_carry: " << std::endl;
+        // reference sums and differences in 128 bits
+        using wide = unsigned __int128;
+        std::vector<wide> wide_res(simd_size);
+        for(int i = 0; i < simd_size; i++){
+            wide_res[i] = wide(data_x[i]) + wide(data_y[i]) + wide(i % 2 == 0);
+            data_res[i] = T(wide_res[i]);
+        }
+        success &= test_equal(add_with_carry(x, y, carry_in, carry_out), data_res);
+        bool ok = true;
+        for(int i = 0; i < simd_size; i++)
+            ok &= carry_out[i] == bool(wide_res[i] >> (8 * sizeof(T)));
+        success &= test_true(ok);
+        std::cout << "sub_with_borrow: " << std::endl;
+        simd_mask<T> borrow_out;
+        for(int i = 0; i < simd_size; i++){
+            wide_res[i] = wide(data_y[i]) - wide(data_x[i]) - wide(i % 2 == 0);
+            data_res[i] = T(wide_res[i]);
+        }
+        success &= test_equal(sub_with_borrow(y, x, carry_in, borrow_out), data_res);
+        ok = true;
+        for(int i = 0; i < simd_size; i++)
+            ok &= borrow_out[i] == bool(wide_res[i] >> (8 * sizeof(T)));
+        success &= test_true(ok);
+    }
+
     {
     std::vector<T> data(rand_data);
     simd<T> x(data.data(), vector_aligned);
@@ -270,6 +438,163 @@ bool test(){
         std::transform(data.begin(), data.end(), data.begin(), [](auto a){ return std::sqrt(a); });
         success &= test_equal(sqrt(x), data);
     }
+    // rounding
+    if constexpr(std::is_floating_point_v<T>)
+    {
+        std::vector<T> data(rand_data), data_res(simd_size);
+        // include halfway cases and signed zeros
+        data[0] = T(-2.5);
+        data[1] = T(-0.5);
+        data[simd_size - 1] = T(0.5);
+        simd<T> x(data.data(), vector_aligned);
+        auto test_rounding = [&](simd<T> res, auto ref){
+            std::transform(data.begin(), data.end(), data_res.begin(), ref);
+            bool same_sign = true;
+            for(int i = 0; i < simd_size; i++)
+                same_sign &= std::signbit(res[i]) == std::signbit(data_res[i]);
+            return test_equal(res, data_res) && test_true(same_sign);
+        };
+        std::cout << "floor: " << std::endl;
+        success &= test_rounding(floor(x), [](T a){ return std::floor(a); });
+        std::cout << "ceil: " << std::endl;
+        success &= test_rounding(ceil(x), [](T a){ return std::ceil(a); });
+        std::cout << "trunc: " << std::endl;
+        success &= test_rounding(trunc(x), [](T a){ return std::trunc(a); });
+        std::cout << "round: " << std::endl;
+        success &= test_rounding(round(x), [](T a){ return std::round(a); });
+        std::cout << "nearbyint: " << std::endl;
+        success &= test_rounding(nearbyint(x), [](T a){ return std::nearbyint(a); });
+
+        using I = std::conditional_t<sizeof(T) == 4, int32_t, int64_t>;
+        std::vector<I> ints(simd_size);
+        std::cout << "lround: " << std::endl;
+        std::transform(data.begin(), data.end(), ints.begin(), [](T a){ return I(std::round(a)); });
+        success &= test_equal(lround(x), ints);
+        std::cout << "to_int: " << std::endl;
+        std::transform(data.begin(), data.end(), ints.begin(), [](T a){ return I(a); });
+        success &= test_equal(to_int(x), ints);
+        std::transform(data.begin(), data.end(), ints.begin(), [](T a){ return I(std::floor(a)); });
+        success &= test_equal(to_int<rounding_mode::downward>(x), ints);
+        std::cout << "to_float: " << std::endl;
+        std::transform(ints.begin(), ints.end(), data_res.begin(), [](I a){ return T(a); });
+        success &= test_equal(to_float(simd<I>(ints.data(), vector_aligned)), data_res);
+
+        // saturation and values that are already integral
+        std::vector<T> big(simd_size, T(1e30));
+        big[0] = -T(1e30);
+        big[1] = std::numeric_limits<T>::infinity();
+        std::vector<I> saturated(simd_size, std::numeric_limits<I>::max());
+        saturated[0] = std::numeric_limits<I>::min();
+        simd<T> y(big.data(), vector_aligned);
+        std::cout << "to_int saturation: " << std::endl;
+        success &= test_equal(to_int(y), saturated);
+        success &= test_equal(floor(y), big);
+    }
+    // classification
+    if constexpr(std::is_floating_point_v<T>)
+    {
+        const T inf = std::numeric_limits<T>::infinity();
+        const T values[] = {T(1.5), -T(0.0), inf, -inf, std::numeric_limits<T>::quiet_NaN(),
+            -std::numeric_limits<T>::quiet_NaN(), std::numeric_limits<T>::denorm_min(), T(0), -T(2)};
+        std::vector<T> data(simd_size);
+        for(int i = 0; i < simd_size; i++)
+            data[i] = values[i % std::size(values)];
+        simd<T> x(data.data(), vector_aligned);
+        auto test_mask = [&](simd_mask<T> res, auto ref){
+            bool ok = true;
+            for(int i = 0; i < simd_size; i++)
+                ok &= res[i] == bool(ref(data[i]));
+            return test_true(ok);
+        };
+        std::cout << "isnan, isinf, isfinite, isnormal, signbit: " << std::endl;
+        success &= test_mask(isnan(x), [](T a){ return std::isnan(a); });
+        success &= test_mask(isinf(x), [](T a){ return std::isinf(a); });
+        success &= test_mask(isfinite(x), [](T a){ return std::isfinite(a); });
+        success &= test_mask(isnormal(x), [](T a){ return std::isnormal(a); });
+        success &= test_mask(signbit(x), [](T a){ return std::signbit(a); });
+        success &= test_mask(is_fp_class<fp_class::nan | fp_class::infinity>(x), [](T a){ return !std::isfinite(a); });
+        std::cout << "fpclassify: " << std::endl;
+        auto classes = fpclassify(x);
+        bool ok = true;
+        for(int i = 0; i < simd_size; i++)
+            ok &= classes[i] == std::fpclassify(data[i]);
+        success &= test_true(ok);
+    }
+    // reciprocal and rsqrt, checked against the bits of precision per step
+    if constexpr(std::is_floating_point_v<T>)
+    {
+        std::vector<T> data(rand_data_positive);
+        std::transform(data.begin(), data.end(), data.begin(), [](auto a){ return a + T(1); });
+        simd<T> x(data.data(), vector_aligned);
+        auto within = [&](simd<T> res, auto ref, T tolerance){
+            bool ok = true;
+            for(int i = 0; i < simd_size; i++){
+                T expected = ref(data[i]);
+                ok &= std::abs(res[i] - expected) <= tolerance * expected;
+            }
+            return test_true(ok);
+        };
+        auto recip_ref = [](T a){ return T(1) / a; };
+        auto rsqrt_ref = [](T a){ return T(1) / std::sqrt(a); };
+        const T full = 8 * std::numeric_limits<T>::epsilon();
+        std::cout << "reciprocal: " << std::endl;
+        success &= within(reciprocal_estimate(x), recip_ref, T(1.0 / 128));
+        success &= within(reciprocal<1>(x), recip_ref, T(1.0 / (1 << 13)));
+        success &= within(reciprocal<3>(x), recip_ref, full);
+        std::cout << "rsqrt: " << std::endl;
+        success &= within(rsqrt_estimate(x), rsqrt_ref, T(1.0 / 128));
+        success &= within(rsqrt<1>(x), rsqrt_ref, T(1.0 / (1 << 13)));
+        success &= within(rsqrt<3>(x), rsqrt_ref, full);
+    }
+    }
+
+    // Permutations
+    {
+    using U = rvv_impl::index_of<T>;
+    std::vector<T> data(rand_data), data_res(simd_size);
+    std::vector<U> idx(simd_size);
+    simd<T> x(data.data(), vector_aligned);
+    std::cout << "Permutations" << std::endl;
+    std::cout << "permute: " << std::endl;
+    for(int i = 0; i < simd_size; i++)
+        idx[i] = U(std::rand() % simd_size);
+    for(int i = 0; i < simd_size; i++)
+        data_res[i] = data[idx[i]];
+    success &= test_equal(permute(x, simd<U>(idx.data(), vector_aligned)), data_res);
+    std::cout << "gather: " << std::endl;
+    success &= test_equal(gather(data.data(), simd<U>(idx.data(), vector_aligned)), data_res);
+    std::cout << "scatter: " << std::endl;
+    {
+    // lane i goes to simd_size - 1 - i, the first lanes only to the front
+    std::vector<T> scattered(data.size(), T(0)), expected(data.size(), T(0));
+    for(int i = 0; i < simd_size; i++)
+        idx[i] = U(simd_size - 1 - i);
+    for(int i = 0; i < simd_size; i++)
+        expected[simd_size - 1 - i] = data[i];
+    scatter(x, scattered.data(), simd<U>(idx.data(), vector_aligned));
+    success &= test_true(scattered == expected);
+    std::fill(scattered.begin(), scattered.end(), T(0));
+    scatter(x, scattered.data(), simd<U>(idx.data(), vector_aligned), 1);
+    success &= test_true(scattered[simd_size - 1] == data[0] &&
+        std::count(scattered.begin(), scattered.end(), T(0)) >= int(data.size()) - 1);
+    }
+    std::cout << "slide_up, slide_down: " << std::endl;
+    for(int n : {0, 1, simd_size / 2, simd_size}){
+        std::vector<T> up(simd_size, T(0)), down(simd_size, T(0));
+        std::copy(data.begin(), data.end() - n, up.begin() + n);
+        std::copy(data.begin() + n, data.end(), down.begin());
+        success &= test_equal(slide_up(x, n), up);
+        success &= test_equal(slide_down(x, n), down);
+    }
+    std::cout << "reverse: " << std::endl;
+    std::reverse_copy(data.begin(), data.end(), data_res.begin());
+    success &= test_equal(reverse(x), data_res);
+    std::cout << "compact: " << std::endl;
+    simd_mask<T> m = x < T(0);
+    auto end = std::copy_if(data.begin(), data.end(), data_res.begin(), [](T a){ return a < T(0); });
+    std::vector<T> packed(simd_size);
+    compact(m, x).copy_to(packed.data(), vector_aligned);
+    success &= test_true(std::equal(data_res.begin(), end, packed.begin()));
     }
 
     // Reduction algorithms
@@ -0,0 +1,87 @@
+#include <rvv/rvv.hpp>
+#include <rvv/radix_sort.hpp>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <cstdlib>
+#include <ctime>
+
+
+bool test_true(bool x){
+    if(!x){
+        std::cout << "Test failed!" << std::endl;
+    }
+    return x;
+}
+
+template <typename T>
+T random_key(uint64_t range){
+    uint64_t bits = (uint64_t(std::rand()) << 42) ^ (uint64_t(std::rand()) << 21) ^ uint64_t(std::rand());
+    if constexpr(std::is_floating_point_v<T>)
+        return T(int64_t(bits % range) - int64_t(range / 2)) / T(8);
+    else if constexpr(std::is_signed_v<T>)
+        return range ? T(int64_t(bits % range) - int64_t(range / 2)) : T(bits);
+    else
+        return range ? T(bits % range) : T(bits);
+}
+
+template <typename T, typename V>
+bool test(){
+    bool success = true;
+    const size_t lanes = rvv::experimental::simd<T>::size();
+
+    std::cout << "radix_sort" << std::endl;
+    for(size_t size : {size_t(0), size_t(1), lanes - 1, lanes, 3 * lanes + 1, size_t(1000), size_t(65537)}){
+        for(uint64_t range : {uint64_t(1), uint64_t(5), uint64_t(1000), uint64_t(0)}){
+            if(std::is_floating_point_v<T> && range == 0)
+                range = uint64_t(1) << 40;
+            std::vector<T> keys(size);
+            std::generate(keys.begin(), keys.end(), [&](){ return random_key<T>(range); });
+            std::vector<V> values(size);
+            std::iota(values.begin(), values.end(), V(0));
+
+            // stable reference on (key, value) pairs
+            std::vector<std::pair<T, V>> expected(size);
+            for(size_t i = 0; i < size; i++)
+                expected[i] = {keys[i], values[i]};
+            std::stable_sort(expected.begin(), expected.end(),
+                [](const auto& a, const auto& b){ return a.first < b.first; });
+
+            auto sorted = keys;
+            rvv::radix_sort(sorted);
+            rvv::radix_sort(keys, values);
+            bool ok = true;
+            for(size_t i = 0; i < size; i++){
+                ok &= sorted[i] == expected[i].first;
+                ok &= keys[i] == expected[i].first && values[i] == expected[i].second;
+            }
+            if(!ok)
+                std::cout << "mismatch for size " << size << " range " << range << std::endl;
+            success &= test_true(ok);
+        }
+    }
+    return success;
+}
+
+
+int main(){
+    std::srand(std::time(nullptr));
+
+    bool success = true;
+
+    std::cout << "Testing uint32_t" << std::endl;
+    success &= test<uint32_t, uint32_t>();
+    std::cout << "Testing int32_t" << std::endl;
+    success &= test<int32_t, int32_t>();
+    std::cout << "Testing float" << std::endl;
+    success &= test<float, uint32_t>();
+    std::cout << "Testing uint64_t" << std::endl;
+    success &= test<uint64_t, uint64_t>();
+    std::cout << "Testing int64_t" << std::endl;
+    success &= test<int64_t, double>();
+    std::cout << "Testing double" << std::endl;
+    success &= test<double, int64_t>();
+
+    return success ? 0 : -1;
+}
@@ -0,0 +1,141 @@
+#include <rvv/rvv.hpp>
+#include <rvv/sort.hpp>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <cstdlib>
+#include <ctime>
+
+
+bool test_true(bool x){
+    if(!x){
+        std::cout << "Test failed!" << std::endl;
+    }
+    return x;
+}
+
+template <typename T>
+std::vector<T> random_vector(size_t size, int range){
+    std::vector<T> v(size);
+    for(auto& x : v)
+        x = T(std::rand() % range - (std::is_signed_v<T> ? range / 2 : 0));
+    return v;
+}
+
+template <typename T>
+std::vector<T> lanes_of(const rvv::experimental::simd<T>& x){
+    std::vector<T> v(x.size());
+    x.copy_to(v.data(), rvv::experimental::element_aligned);
+    return v;
+}
+
+template <typename T>
+bool test(){
+    bool success = true;
+    using namespace rvv::experimental;
+    const size_t simd_size = simd<T>::size();
+
+    std::cout << "sort(simd)" << std::endl;
+    for(int range : {3, 100}){
+        auto data = random_vector<T>(simd_size, range);
+        simd<T> x(data.data(), element_aligned), y = x;
+        sort(x);
+        sort(y, std::greater<>{});
+        auto expected = data;
+        std::sort(expected.begin(), expected.end());
+        bool ok = lanes_of(x) == expected;
+        std::reverse(expected.begin(), expected.end());
+        ok &= lanes_of(y) == expected;
+        if(!ok)
+            std::cout << "x: " << x << std::endl << "y: " << y << std::endl;
+        success &= test_true(ok);
+    }
+
+    std::cout << "merge" << std::endl;
+    for(int range : {3, 100}){
+        auto data = random_vector<T>(2 * simd_size, range);
+        simd<T> lo(data.data(), element_aligned), hi(data.data() + simd_size, element_aligned);
+        sort(lo);
+        sort(hi);
+        merge(lo, hi);
+        auto expected = data;
+        std::sort(expected.begin(), expected.end());
+        auto result = lanes_of(lo);
+        auto upper = lanes_of(hi);
+        result.insert(result.end(), upper.begin(), upper.end());
+        bool ok = result == expected;
+        sort(lo, std::greater<>{});
+        sort(hi, std::greater<>{});
+        merge(lo, hi, std::greater<>{});
+        std::reverse(expected.begin(), expected.end());
+        result = lanes_of(lo);
+        upper = lanes_of(hi);
+        result.insert(result.end(), upper.begin(), upper.end());
+        ok &= result == expected;
+        success &= test_true(ok);
+    }
+
+    std::cout << "rvv::sort" << std::endl;
+    for(size_t size : {size_t(0), size_t(1), size_t(2), simd_size - 1, simd_size, simd_size + 1,
+            2 * simd_size, 2 * simd_size + 1, 5 * simd_size + 3, size_t(1000), size_t(10007)}){
+        for(int range : {2, 50, 1 << 30}){
+            auto data = random_vector<T>(size, range);
+            auto expected = data;
+            std::sort(expected.begin(), expected.end());
+            auto sorted = data;
+            rvv::sort(sorted);
+            bool ok = sorted == expected;
+            sorted = data;
+            rvv::sort(sorted.data(), sorted.data() + size, std::greater<>{});
+            std::reverse(expected.begin(), expected.end());
+            ok &= sorted == expected;
+            if(!ok)
+                std::cout << "mismatch for size " << size << " range " << range << std::endl;
+            success &= test_true(ok);
+        }
+    }
+
+    // already sorted, reversed and constant input
+    {
+        std::vector<T> data(3000);
+        for(size_t i = 0; i < data.size(); i++)
+            data[i] = T(i % 100);
+        std::sort(data.begin(), data.end());
+        auto expected = data;
+        rvv::sort(data);
+        bool ok = data == expected;
+        std::reverse(data.begin(), data.end());
+        rvv::sort(data);
+        ok &= data == expected;
+        std::fill(data.begin(), data.end(), T(7));
+        rvv::sort(data);
+        ok &= std::all_of(data.begin(), data.end(), [](T x){ return x == T(7); });
+        success &= test_true(ok);
+    }
+    return success;
+}
+
+
+int main(){
+    std::srand(std::time(nullptr));
+
+    bool success = true;
+
+    std::cout << "Testing int8_t" << std::endl;
+    success &= test<int8_t>();
+    std::cout << "Testing uint16_t" << std::endl;
+    success &= test<uint16_t>();
+    std::cout << "Testing int32_t" << std::endl;
+    success &= test<int32_t>();
+    std::cout << "Testing uint32_t" << std::endl;
+    success &= test<uint32_t>();
+    std::cout << "Testing int64_t" << std::endl;
+    success &= test<int64_t>();
+    std::cout << "Testing float" << std::endl;
+    success &= test<float>();
+    std::cout << "Testing double" << std::endl;
+    success &= test<double>();
+
+    return success ? 0 : -1;
+}
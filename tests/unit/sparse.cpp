@@ -0,0 +1,98 @@
+#include <rvv/rvv.hpp>
+#include <rvv/sparse.hpp>
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <cstdlib>
+#include <ctime>
+
+
+bool test_true(bool x){
+    if(!x){
+        std::cout << "Test failed!" << std::endl;
+    }
+    return x;
+}
+
+template <typename T>
+bool approximately_equal(const std::vector<T>& x, const std::vector<T>& y, T tolerance){
+    for(size_t i = 0; i < x.size(); i++)
+        if(!(std::abs(x[i] - y[i]) <= tolerance * (T(1) + std::abs(y[i]))))
+            return false;
+    return true;
+}
+
+// rows of random length up to max_length, column 0 is never used so that
+// x[0] can be infinite
+template <typename T>
+rvv::sparse::csr_matrix<T> random_matrix(size_t rows, size_t cols, size_t max_length){
+    rvv::sparse::csr_matrix<T> a;
+    a.rows = rows;
+    a.cols = cols;
+    a.row_ptr.push_back(0);
+    for(size_t i = 0; i < rows; i++){
+        size_t length = std::rand() % (max_length + 1);
+        for(size_t j = 0; j < length; j++){
+            a.col.push_back(rvv::sparse::index_t<T>(1 + std::rand() % (cols - 1)));
+            a.values.push_back(T(std::rand() % 200 - 100) / T(16));
+        }
+        a.row_ptr.push_back(a.col.size());
+    }
+    return a;
+}
+
+template <typename T>
+bool test(){
+    bool success = true;
+    const T tolerance = std::is_same_v<T, float> ? T(1e-4) : T(1e-10);
+    const size_t lanes = rvv::experimental::simd<T>::size();
+
+    std::cout << "spmv_csr, spmv" << std::endl;
+    for(size_t rows : {size_t(1), lanes - 1, 3 * lanes + 2, size_t(500)}){
+        for(size_t max_length : {size_t(0), size_t(3), 2 * lanes + 1, size_t(100)}){
+            const size_t cols = 300;
+            auto a = random_matrix<T>(rows, cols, max_length);
+            std::vector<T> x(cols);
+            for(auto& v : x)
+                v = T(std::rand() % 100) / T(8);
+            x[0] = std::numeric_limits<T>::infinity();
+
+            std::vector<T> expected(rows);
+            for(size_t i = 0; i < rows; i++){
+                T sum = T(0);
+                for(size_t k = a.row_ptr[i]; k < a.row_ptr[i + 1]; k++)
+                    sum += a.values[k] * x[a.col[k]];
+                expected[i] = sum;
+            }
+
+            std::vector<T> y(rows, T(-1));
+            rvv::sparse::spmv_csr(a, x.data(), y.data());
+            bool ok = approximately_equal(y, expected, tolerance);
+            for(size_t sigma : {size_t(1), lanes, size_t(64)}){
+                auto s = rvv::sparse::to_sell(a, sigma);
+                std::fill(y.begin(), y.end(), T(-1));
+                rvv::sparse::spmv(s, x.data(), y.data());
+                ok &= approximately_equal(y, expected, tolerance);
+            }
+            if(!ok)
+                std::cout << "mismatch for " << rows << " rows of up to " << max_length << std::endl;
+            success &= test_true(ok);
+        }
+    }
+    return success;
+}
+
+
+int main(){
+    std::srand(std::time(nullptr));
+
+    bool success = true;
+
+    std::cout << "Testing float" << std::endl;
+    success &= test<float>();
+    std::cout << "Testing double" << std::endl;
+    success &= test<double>();
+
+    return success ? 0 : -1;
+}
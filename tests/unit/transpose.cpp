@@ -0,0 +1,85 @@
+#include <rvv/rvv.hpp>
+#include <rvv/transpose.hpp>
+#include <iostream>
+#include <vector>
+#include <array>
+#include <cstdlib>
+#include <ctime>
+
+
+bool test_true(bool x){
+    if(!x){
+        std::cout << "Test failed!" << std::endl;
+    }
+    return x;
+}
+
+template <typename T, size_t K>
+bool test_tiles(){
+    using namespace rvv::experimental;
+    constexpr size_t N = simd<T>::size();
+    std::vector<T> data(K * N), result(K * N);
+    for(auto& x : data)
+        x = T(std::rand() % 100);
+    std::array<simd<T>, K> x;
+    for(size_t r = 0; r < K; r++)
+        x[r].copy_from(data.data() + r * N, element_aligned);
+    transpose(x);
+    for(size_t r = 0; r < K; r++)
+        x[r].copy_to(result.data() + r * N, element_aligned);
+    // tile t covers the lanes t * K .. t * K + K - 1 of every register
+    bool ok = true;
+    for(size_t r = 0; r < K; r++)
+        for(size_t lane = 0; lane < N; lane++)
+            ok &= result[r * N + lane] == data[(lane % K) * N + lane / K * K + r];
+    return ok;
+}
+
+template <typename T>
+bool test(){
+    bool success = true;
+    constexpr size_t N = rvv::experimental::simd<T>::size();
+
+    std::cout << "transpose of tiles" << std::endl;
+    success &= test_true(test_tiles<T, 1>());
+    success &= test_true(test_tiles<T, 2>());
+    success &= test_true(test_tiles<T, N>());
+
+    std::cout << "transpose" << std::endl;
+    for(size_t rows : {size_t(1), N - 1, N, 3 * N + 1, size_t(70), size_t(130)}){
+        for(size_t cols : {size_t(1), size_t(3), N, 2 * N + 5, size_t(129)}){
+            std::vector<T> src(rows * cols), dst(rows * cols + 1, T(7));
+            for(auto& x : src)
+                x = T(std::rand() % 100);
+            rvv::transpose(src.data(), dst.data(), rows, cols);
+            bool ok = dst.back() == T(7);
+            for(size_t i = 0; i < rows; i++)
+                for(size_t j = 0; j < cols; j++)
+                    ok &= dst[j * rows + i] == src[i * cols + j];
+            if(!ok)
+                std::cout << "mismatch for " << rows << "x" << cols << std::endl;
+            success &= test_true(ok);
+        }
+    }
+    return success;
+}
+
+
+int main(){
+    std::srand(std::time(nullptr));
+
+    bool success = true;
+
+    std::cout << "Testing int8_t" << std::endl;
+    success &= test<int8_t>();
+    std::cout << "Testing uint16_t" << std::endl;
+    success &= test<uint16_t>();
+    std::cout << "Testing float" << std::endl;
+    success &= test<float>();
+    std::cout << "Testing double" << std::endl;
+    success &= test<double>();
+    std::cout << "Testing int64_t" << std::endl;
+    success &= test<int64_t>();
+
+    return success ? 0 : -1;
+}